@@ -431,6 +431,19 @@ void GetASCIICode(unsigned char* pBuffer,unsigned char ASCII)
 }
 
 
+/*******************************************************************************
+* Function Name  : GetASCIIGlyph
+* Description    : Returns the 16 rows of a character, without copying them
+* Input          : - ASCII: character, from ' ' to '~'
+* Output         : None
+* Return         : Pointer to the rows in FLASH, MSB is the leftmost pixel
+* Attention		 : None
+*******************************************************************************/
+const unsigned char *GetASCIIGlyph(unsigned char ASCII)
+{
+   return AsciiLib[(ASCII - 32)];
+}
+
 /*********************************************************************************************************
       END FILE
 *********************************************************************************************************/
@@ -23,7 +23,11 @@
 #define __GLCD_H
 
 /* Includes ------------------------------------------------------------------*/
+#ifdef GLCD_EMULATOR
+#include <stdint.h>			/* host build, see GLCD_emu.c */
+#else
 #include "LPC17xx.h"
+#endif
 
 /* Private define ------------------------------------------------------------*/
 
@@ -36,13 +40,23 @@
 #define PIN_WR		(1 << 24)
 #define PIN_RD		(1 << 25)   
 
-#define LCD_EN(x)   ((x) ? (LPC_GPIO0->FIOSET = PIN_EN) : (LPC_GPIO0->FIOCLR = PIN_EN));
-#define LCD_LE(x)   ((x) ? (LPC_GPIO0->FIOSET = PIN_LE) : (LPC_GPIO0->FIOCLR = PIN_LE));
-#define LCD_DIR(x)  ((x) ? (LPC_GPIO0->FIOSET = PIN_DIR) : (LPC_GPIO0->FIOCLR = PIN_DIR));
-#define LCD_CS(x)   ((x) ? (LPC_GPIO0->FIOSET = PIN_CS) : (LPC_GPIO0->FIOCLR = PIN_CS));
-#define LCD_RS(x)   ((x) ? (LPC_GPIO0->FIOSET = PIN_RS) : (LPC_GPIO0->FIOCLR = PIN_RS));
-#define LCD_WR(x)   ((x) ? (LPC_GPIO0->FIOSET = PIN_WR) : (LPC_GPIO0->FIOCLR = PIN_WR));
-#define LCD_RD(x)   ((x) ? (LPC_GPIO0->FIOSET = PIN_RD) : (LPC_GPIO0->FIOCLR = PIN_RD));
+/* Bus statistics: define GLCD_STATS to count the GPIO writes issued to the LCD.
+   The GLCD_EMULATOR build runs the same sequences on the stand-ins of GLCD_emu.h,
+   so it counts the writes of the board */
+#ifdef GLCD_STATS
+extern volatile uint32_t LCD_GpioWrites;
+#define LCD_GPIO_COUNT(n)	(LCD_GpioWrites += (n))
+#else
+#define LCD_GPIO_COUNT(n)	((void)0)
+#endif
+
+#define LCD_EN(x)   (LCD_GPIO_COUNT(1), (x) ? (LPC_GPIO0->FIOSET = PIN_EN) : (LPC_GPIO0->FIOCLR = PIN_EN));
+#define LCD_LE(x)   (LCD_GPIO_COUNT(1), (x) ? (LPC_GPIO0->FIOSET = PIN_LE) : (LPC_GPIO0->FIOCLR = PIN_LE));
+#define LCD_DIR(x)  (LCD_GPIO_COUNT(1), (x) ? (LPC_GPIO0->FIOSET = PIN_DIR) : (LPC_GPIO0->FIOCLR = PIN_DIR));
+#define LCD_CS(x)   (LCD_GPIO_COUNT(1), (x) ? (LPC_GPIO0->FIOSET = PIN_CS) : (LPC_GPIO0->FIOCLR = PIN_CS));
+#define LCD_RS(x)   (LCD_GPIO_COUNT(1), (x) ? (LPC_GPIO0->FIOSET = PIN_RS) : (LPC_GPIO0->FIOCLR = PIN_RS));
+#define LCD_WR(x)   (LCD_GPIO_COUNT(1), (x) ? (LPC_GPIO0->FIOSET = PIN_WR) : (LPC_GPIO0->FIOCLR = PIN_WR));
+#define LCD_RD(x)   (LCD_GPIO_COUNT(1), (x) ? (LPC_GPIO0->FIOSET = PIN_RD) : (LPC_GPIO0->FIOCLR = PIN_RD));
 
 /* Private define ------------------------------------------------------------*/
 #define DISP_ORIENTATION  0  /* angle 0 90 */ 
@@ -88,12 +102,20 @@
 
 /* Private function prototypes -----------------------------------------------*/
 void LCD_Initialization(void);
+uint32_t LCD_FirstFrame(void);
 void LCD_Clear(uint16_t Color);
+void LCD_FillRect(uint16_t Xpos, uint16_t Ypos, uint16_t Width, uint16_t Height, uint16_t Color);
+uint32_t LCD_BeginWrite(uint16_t Xpos, uint16_t Ypos, uint16_t Width, uint16_t Height);
+void LCD_PushPixels(const uint16_t *pixels, uint32_t count);
+void LCD_PushColor(uint16_t Color, uint32_t count);
+void LCD_EndWrite(void);
 uint16_t LCD_GetPoint(uint16_t Xpos,uint16_t Ypos);
 void LCD_SetPoint(uint16_t Xpos,uint16_t Ypos,uint16_t point);
 void LCD_DrawLine( uint16_t x0, uint16_t y0, uint16_t x1, uint16_t y1 , uint16_t color );
 void PutChar( uint16_t Xpos, uint16_t Ypos, uint8_t ASCI, uint16_t charColor, uint16_t bkColor );
+void PutCharRotated( uint16_t Xpos, uint16_t Ypos, uint8_t ASCI, uint16_t charColor, uint16_t bkColor, uint16_t angle );
 void GUI_Text(uint16_t Xpos, uint16_t Ypos, uint8_t *str,uint16_t Color, uint16_t bkColor);
+void GUI_TextRotated(uint16_t Xpos, uint16_t Ypos, uint8_t *str, uint16_t Color, uint16_t bkColor, uint16_t angle);
 
 #endif 
 
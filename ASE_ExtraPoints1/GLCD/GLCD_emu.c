@@ -0,0 +1,382 @@
+/*********************************************************************************************************
+**--------------File Info---------------------------------------------------------------------------------
+** File name:           GLCD_emu.c
+** Last modified Date:  2026-10-17
+** Last Version:        V1.00
+** Descriptions:        host-side ILI9325 model used by the GLCD_EMULATOR build:
+**                      registers, GRAM window, cursor, entry mode and auto-increment,
+**                      frame dumps and bus cycle counters
+** Correlated files:    GLCD_emu.h, GLCD.c
+**--------------------------------------------------------------------------------------------------------
+*********************************************************************************************************/
+#include <string.h>
+#include "GLCD_emu.h"
+
+/* Registers of the ILI9325 used by the driver */
+#define REG_ID				0x00
+#define REG_ENTRY			0x03
+#define REG_AC_X			0x20
+#define REG_AC_Y			0x21
+#define REG_GRAM			0x22
+#define REG_HSA				0x50
+#define REG_HEA				0x51
+#define REG_VSA				0x52
+#define REG_VEA				0x53
+
+/* Entry mode bits */
+#define ENTRY_AM			(1 << 3)
+#define ENTRY_ID0			(1 << 4)
+#define ENTRY_ID1			(1 << 5)
+
+static uint16_t regs[256];
+static uint16_t gram[EMU_GRAM_Y][EMU_GRAM_X];
+static uint8_t index_reg;
+static uint16_t ac_x, ac_y;
+static uint8_t dummy_read;
+
+static LCDEmu_Stats stats;
+static LCDEmu_Primitive primitives[EMU_MAX_PRIMITIVES];
+static LCDEmu_Primitive *current;
+static LCDEmu_Stats begin_stats;
+
+LCDEmu_Gpio LCDEmu_Gpio0, LCDEmu_Gpio2;
+
+/******************************************************************************
+** Function name:		LCDEmu_Init
+**
+** Descriptions:		Power-on state of the controller
+**
+** parameters:			None
+** Returned value:		None
+**
+******************************************************************************/
+void LCDEmu_Init(void)
+{
+	memset(regs, 0, sizeof(regs));
+	memset(gram, 0, sizeof(gram));
+	regs[REG_ID] = 0x9325;
+	regs[REG_ENTRY] = ENTRY_ID1 | ENTRY_ID0;
+	regs[REG_HEA] = EMU_GRAM_X - 1;
+	regs[REG_VEA] = EMU_GRAM_Y - 1;
+	index_reg = 0;
+	ac_x = 0;
+	ac_y = 0;
+	dummy_read = 0;
+}
+
+/******************************************************************************
+** Function name:		AdvanceCursor
+**
+** Descriptions:		Moves the address counter after a GRAM access,
+**									following ID1/ID0/AM and wrapping inside the window
+**
+** parameters:			None
+** Returned value:		None
+**
+******************************************************************************/
+static void AdvanceCursor(void)
+{
+	uint16_t hsa = regs[REG_HSA], hea = regs[REG_HEA];
+	uint16_t vsa = regs[REG_VSA], vea = regs[REG_VEA];
+	uint16_t entry = regs[REG_ENTRY];
+	int wrap;
+
+	if( (entry & ENTRY_AM) == 0 )
+	{
+		/* Horizontal first */
+		if( entry & ENTRY_ID0 )
+		{
+			wrap = ac_x >= hea;
+			ac_x = wrap ? hsa : ac_x + 1;
+		}
+		else
+		{
+			wrap = ac_x <= hsa;
+			ac_x = wrap ? hea : ac_x - 1;
+		}
+		if( wrap )
+		{
+			if( entry & ENTRY_ID1 )
+			{
+				ac_y = ac_y >= vea ? vsa : ac_y + 1;
+			}
+			else
+			{
+				ac_y = ac_y <= vsa ? vea : ac_y - 1;
+			}
+		}
+	}
+	else
+	{
+		/* Vertical first */
+		if( entry & ENTRY_ID1 )
+		{
+			wrap = ac_y >= vea;
+			ac_y = wrap ? vsa : ac_y + 1;
+		}
+		else
+		{
+			wrap = ac_y <= vsa;
+			ac_y = wrap ? vea : ac_y - 1;
+		}
+		if( wrap )
+		{
+			if( entry & ENTRY_ID0 )
+			{
+				ac_x = ac_x >= hea ? hsa : ac_x + 1;
+			}
+			else
+			{
+				ac_x = ac_x <= hsa ? hea : ac_x - 1;
+			}
+		}
+	}
+}
+
+/******************************************************************************
+** Function name:		LCDEmu_WriteIndex
+**
+** Descriptions:		Bus write with RS low: selects a register
+**
+** parameters:			index: register index
+** Returned value:		None
+**
+******************************************************************************/
+void LCDEmu_WriteIndex(uint16_t index)
+{
+	stats.index_writes++;
+	index_reg = (uint8_t)index;
+	if( index_reg == REG_GRAM )
+	{
+		dummy_read = 1;
+	}
+}
+
+/******************************************************************************
+** Function name:		LCDEmu_WriteData
+**
+** Descriptions:		Bus write with RS high: writes the selected register,
+**									or a pixel at the address counter for 0x22
+**
+** parameters:			data: register value or RGB565 pixel
+** Returned value:		None
+**
+******************************************************************************/
+void LCDEmu_WriteData(uint16_t data)
+{
+	stats.data_writes++;
+	switch( index_reg )
+	{
+		case REG_GRAM:
+			stats.pixels++;
+			if( ac_x < EMU_GRAM_X && ac_y < EMU_GRAM_Y )
+			{
+				gram[ac_y][ac_x] = data;
+			}
+			AdvanceCursor();
+			break;
+		case REG_AC_X:
+			ac_x = data & 0xFF;
+			regs[index_reg] = ac_x;
+			break;
+		case REG_AC_Y:
+			ac_y = data & 0x1FF;
+			regs[index_reg] = ac_y;
+			break;
+		case REG_ID:
+			/* the device code is read only, writing 1 starts the oscillator */
+			break;
+		default:
+			regs[index_reg] = data;
+			break;
+	}
+}
+
+/******************************************************************************
+** Function name:		LCDEmu_ReadData
+**
+** Descriptions:		Bus read with RS high: the first GRAM read after the
+**									index is a dummy one, pixels are returned BGR ordered
+**
+** parameters:			None
+** Returned value:		register value or pixel
+**
+******************************************************************************/
+uint16_t LCDEmu_ReadData(void)
+{
+	uint16_t value;
+
+	stats.data_reads++;
+	if( index_reg != REG_GRAM )
+	{
+		return regs[index_reg];
+	}
+	if( dummy_read )
+	{
+		dummy_read = 0;
+		return 0;
+	}
+	value = ( ac_x < EMU_GRAM_X && ac_y < EMU_GRAM_Y ) ? gram[ac_y][ac_x] : 0;
+	AdvanceCursor();
+	return (uint16_t)( ( (value & 0x1F) << 11 ) | ( value & 0x07E0 ) | ( value >> 11 ) );
+}
+
+/******************************************************************************
+** Function name:		LCDEmu_GetPixel
+**
+** Descriptions:		Reads the GRAM without touching the bus counters
+**
+** parameters:			Xpos, Ypos: physical coordinates
+** Returned value:		RGB565 pixel
+**
+******************************************************************************/
+uint16_t LCDEmu_GetPixel(uint16_t Xpos, uint16_t Ypos)
+{
+	if( Xpos >= EMU_GRAM_X || Ypos >= EMU_GRAM_Y )
+	{
+		return 0;
+	}
+	return gram[Ypos][Xpos];
+}
+
+/******************************************************************************
+** Function name:		LCDEmu_GetReg
+**
+** Descriptions:		Reads a controller register without touching the bus counters
+**
+** parameters:			reg: register index
+** Returned value:		register value
+**
+******************************************************************************/
+uint16_t LCDEmu_GetReg(uint8_t reg)
+{
+	return regs[reg];
+}
+
+/******************************************************************************
+** Function name:		LCDEmu_DumpPPM
+**
+** Descriptions:		Writes the GRAM as a binary PPM (P6) image
+**
+** parameters:			path: output file
+** Returned value:		0 on success, -1 on error
+**
+******************************************************************************/
+int LCDEmu_DumpPPM(const char *path)
+{
+	FILE *f;
+	uint16_t x, y, p;
+	uint8_t rgb[3];
+
+	f = fopen(path, "wb");
+	if( f == NULL )
+	{
+		return -1;
+	}
+	fprintf(f, "P6\n%d %d\n255\n", EMU_GRAM_X, EMU_GRAM_Y);
+	for( y = 0; y < EMU_GRAM_Y; y++ )
+	{
+		for( x = 0; x < EMU_GRAM_X; x++ )
+		{
+			p = gram[y][x];
+			rgb[0] = (uint8_t)( ( (p >> 11) & 0x1F ) * 255 / 31 );
+			rgb[1] = (uint8_t)( ( (p >> 5) & 0x3F ) * 255 / 63 );
+			rgb[2] = (uint8_t)( ( p & 0x1F ) * 255 / 31 );
+			fwrite(rgb, 1, 3, f);
+		}
+	}
+	return fclose(f) == 0 ? 0 : -1;
+}
+
+/******************************************************************************
+** Function name:		LCDEmu_GetStats / LCDEmu_ResetStats
+**
+** Descriptions:		Global bus cycle counters
+**
+******************************************************************************/
+void LCDEmu_GetStats(LCDEmu_Stats *out)
+{
+	*out = stats;
+}
+
+void LCDEmu_ResetStats(void)
+{
+	memset(&stats, 0, sizeof(stats));
+	memset(primitives, 0, sizeof(primitives));
+	current = NULL;
+}
+
+/******************************************************************************
+** Function name:		LCDEmu_Begin
+**
+** Descriptions:		Starts accounting the bus cycles to a named primitive,
+**									until LCDEmu_End is called
+**
+** parameters:			primitive: name, compared by pointer and then by content
+** Returned value:		None
+**
+******************************************************************************/
+void LCDEmu_Begin(const char *primitive)
+{
+	size_t i;
+
+	current = NULL;
+	for( i = 0; i < EMU_MAX_PRIMITIVES && current == NULL; i++ )
+	{
+		if( primitives[i].name == NULL )
+		{
+			primitives[i].name = primitive;
+			current = &primitives[i];
+		}
+		else if( primitives[i].name == primitive || strcmp(primitives[i].name, primitive) == 0 )
+		{
+			current = &primitives[i];
+		}
+	}
+	begin_stats = stats;
+}
+
+void LCDEmu_End(void)
+{
+	if( current == NULL )
+	{
+		return;
+	}
+	current->calls++;
+	current->bus.index_writes += stats.index_writes - begin_stats.index_writes;
+	current->bus.data_writes += stats.data_writes - begin_stats.data_writes;
+	current->bus.data_reads += stats.data_reads - begin_stats.data_reads;
+	current->bus.pixels += stats.pixels - begin_stats.pixels;
+	current = NULL;
+}
+
+/******************************************************************************
+** Function name:		LCDEmu_PrintStats
+**
+** Descriptions:		Prints the per primitive and global bus cycle counters
+**
+** parameters:			out: output stream
+** Returned value:		None
+**
+******************************************************************************/
+void LCDEmu_PrintStats(FILE *out)
+{
+	size_t i;
+	uint32_t cycles;
+
+	fprintf(out, "%-20s %8s %10s %10s %10s\n", "primitive", "calls", "cycles", "cyc/call", "pixels");
+	for( i = 0; i < EMU_MAX_PRIMITIVES && primitives[i].name != NULL; i++ )
+	{
+		cycles = primitives[i].bus.index_writes + primitives[i].bus.data_writes + primitives[i].bus.data_reads;
+		fprintf(out, "%-20s %8lu %10lu %10lu %10lu\n", primitives[i].name,
+			(unsigned long)primitives[i].calls, (unsigned long)cycles,
+			(unsigned long)( primitives[i].calls ? cycles / primitives[i].calls : 0 ),
+			(unsigned long)primitives[i].bus.pixels);
+	}
+	cycles = stats.index_writes + stats.data_writes + stats.data_reads;
+	fprintf(out, "%-20s %8s %10lu %10s %10lu\n", "total", "", (unsigned long)cycles, "", (unsigned long)stats.pixels);
+}
+
+/******************************************************************************
+**                            End Of File
+******************************************************************************/
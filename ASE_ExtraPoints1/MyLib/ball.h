@@ -0,0 +1,63 @@
+#include "fixed.h"
+#include "collide.h"
+
+#ifndef __BALL_H
+#define __BALL_H
+
+/* Number of deflection angles on each side of the vertical, 7.5 degrees apart */
+#define BALL_ANGLES			8
+
+/* Ball speed in px per step at speed 1: the old one pixel diagonal */
+#define BALL_SPEED			92682			/* sqrt(2) */
+#define BALL_SPEEDUP		(FIX_ONE / 16)
+#define BALL_MAX_SPEED	FIX(4)
+
+/* Contacts handled in a single step, a corner already takes two */
+#define BALL_MAX_HITS		4
+
+/* A square ball moving with sub-pixel precision */
+typedef struct {
+	fix16_t x, y;						/* top-left corner, in px			*/
+	fix16_t vx, vy;					/* px per step at speed 1			*/
+	fix16_t speed;					/* multiplier of the velocity	*/
+	uint16_t size;					/* side, in px								*/
+} Ball;
+
+/* Most balls in play at once */
+#define BALL_POOL				8
+
+/* Balls in play, one array per field: a pass over the balls reads each array in order */
+typedef struct {
+	fix16_t x[BALL_POOL], y[BALL_POOL];			/* top-left corners, in px						*/
+	fix16_t vx[BALL_POOL], vy[BALL_POOL];		/* px per step at speed 1							*/
+	fix16_t speed[BALL_POOL];								/* multipliers of the velocities			*/
+	uint16_t count;													/* balls in play, first in the arrays	*/
+	uint16_t size;													/* side of every ball, in px					*/
+} BallPool;
+
+void Ball_Init(Ball *ball, int16_t x, int16_t y, uint16_t size, fix16_t vx, fix16_t vy);
+void Ball_Move(Ball *ball, const Box *obstacles, int count, void (*bounce)(Ball *ball, int index, const Hit *hit));
+void Ball_Reflect(Ball *ball, const Hit *hit);
+void Ball_Deflect(Ball *ball, int16_t offset, int16_t half, int16_t spin, int16_t dir);
+void Ball_SpeedUp(Ball *ball);
+
+void Pool_Init(BallPool *pool, uint16_t size);
+int Pool_Add(BallPool *pool, const Ball *ball);
+void Pool_Get(const BallPool *pool, int i, Ball *ball);
+void Pool_Set(BallPool *pool, int i, const Ball *ball);
+void Pool_Remove(BallPool *pool, int i);
+void Pool_Move(BallPool *pool, const Box *obstacles, int count, void (*bounce)(Ball *ball, int index, const Hit *hit));
+
+/* Pixel edges of the ball, the ball covers [Left, Right] x [Top, Bottom] */
+#define Ball_Left(b)		FIX_INT((b)->x)
+#define Ball_Top(b)			FIX_INT((b)->y)
+#define Ball_Right(b)		(Ball_Left(b) + (b)->size - 1)
+#define Ball_Bottom(b)	(Ball_Top(b) + (b)->size - 1)
+
+/* Pixel edges of the ball i of a pool */
+#define Pool_Left(p, i)		FIX_INT((p)->x[i])
+#define Pool_Top(p, i)		FIX_INT((p)->y[i])
+#define Pool_Right(p, i)	(Pool_Left(p, i) + (p)->size - 1)
+#define Pool_Bottom(p, i)	(Pool_Top(p, i) + (p)->size - 1)
+
+#endif
@@ -0,0 +1,20 @@
+#include "fixed.h"
+
+#ifndef __COLLIDE_H
+#define __COLLIDE_H
+
+/* Axis aligned box, it covers [x, x + w) x [y, y + h) */
+typedef struct {
+	fix16_t x, y, w, h;
+} Box;
+
+/* First contact of a moving box */
+typedef struct {
+	fix16_t t;					/* fraction of the move done at the contact, 0 to FIX_ONE	*/
+	int8_t nx, ny;			/* normal of the face hit, both set on a corner						*/
+} Hit;
+
+int Collide_Sweep(const Box *moving, fix16_t dx, fix16_t dy, const Box *target, Hit *hit);
+int Collide_First(const Box *moving, fix16_t dx, fix16_t dy, const Box *targets, int count, Hit *hit);
+
+#endif
@@ -0,0 +1,141 @@
+#include "counter.h"
+
+/********************************************************************************
+*                                                                               *
+* FUNCTION NAME: DrawDigit				                                              *
+*                                                                               *
+* PURPOSE: Draw a character of the counter in its slot													*
+* ARGUMENT LIST:                                                                *
+*                                                                               *
+* Argument  Type         IO     Description                                     *
+* --------- --------     --     ---------------------------------               *
+* counter		Counter*		 I			Counter																					*
+*	slot			uint8_t			 I			Position of the character, in reading order			*
+*	c					char				 I			Character to draw																*
+*																																								*
+* RETURN VALUE: void                                                            *
+*                                                                               *
+********************************************************************************/
+static void DrawDigit(const Counter *counter, uint8_t slot, char c)
+{
+	if(counter->flags & COUNTER_ROTATED)
+	{
+		/* Upside down, the first character is the rightmost one */
+		PutCharRotated(counter->x + 8 * (counter->digits - 1 - slot), counter->y, c, counter->color, counter->bkColor, 180);
+	}
+	else
+	{
+		PutChar(counter->x + 8 * slot, counter->y, c, counter->color, counter->bkColor);
+	}
+}
+
+/********************************************************************************
+*                                                                               *
+* FUNCTION NAME: Counter_Init			                                              *
+*                                                                               *
+* PURPOSE: Initialize a counter, nothing is drawn until Counter_Show						*
+* ARGUMENT LIST:                                                                *
+*                                                                               *
+* Argument  Type         IO     Description                                     *
+* --------- --------     --     ---------------------------------               *
+* counter		Counter*		 O			Counter to initialize														*
+*	x, y			uint16_t		 I			Top-left corner of the field										*
+*	digits		uint8_t			 I			Width of the field, in characters								*
+*	flags			uint8_t			 I			COUNTER_RIGHT, COUNTER_ROTATED									*
+*	color			uint16_t		 I			Color of the digits															*
+*	bkColor		uint16_t		 I			Color of the background													*
+*																																								*
+* RETURN VALUE: void                                                            *
+*                                                                               *
+********************************************************************************/
+void Counter_Init(Counter *counter, uint16_t x, uint16_t y, uint8_t digits, uint8_t flags, uint16_t color, uint16_t bkColor)
+{
+	uint8_t i;
+
+	counter->x = x;
+	counter->y = y;
+	counter->digits = digits > COUNTER_MAX_DIGITS ? COUNTER_MAX_DIGITS : digits;
+	counter->flags = flags;
+	counter->color = color;
+	counter->bkColor = bkColor;
+	for(i = 0; i < COUNTER_MAX_DIGITS; i++)
+	{
+		counter->shown[i] = 0;
+	}
+}
+
+/********************************************************************************
+*                                                                               *
+* FUNCTION NAME: Counter_Show			                                              *
+*                                                                               *
+* PURPOSE: Show a value, drawing only the characters that changed.							*
+*					 A value wider than the field shows its last digits										*
+* ARGUMENT LIST:                                                                *
+*                                                                               *
+* Argument  Type         IO     Description                                     *
+* --------- --------     --     ---------------------------------               *
+* counter		Counter*		 I/O		Counter to update																*
+*	value			uint32_t		 I			Value to show																		*
+*																																								*
+* RETURN VALUE: void                                                            *
+*                                                                               *
+********************************************************************************/
+void Counter_Show(Counter *counter, uint32_t value)
+{
+	char text[COUNTER_MAX_DIGITS];
+	uint8_t len = 0, i;
+
+	/* Digits from the least significant one, at the end of text */
+	do
+	{
+		text[COUNTER_MAX_DIGITS - 1 - len] = '0' + value % 10;
+		value /= 10;
+		len++;
+	} while(value != 0 && len < counter->digits);
+
+	for(i = 0; i < counter->digits; i++)
+	{
+		char c;
+
+		if(counter->flags & COUNTER_RIGHT)
+		{
+			c = (i < counter->digits - len) ? ' ' : text[COUNTER_MAX_DIGITS - counter->digits + i];
+		}
+		else
+		{
+			c = (i < len) ? text[COUNTER_MAX_DIGITS - len + i] : ' ';
+		}
+		if(c != counter->shown[i])
+		{
+			DrawDigit(counter, i, c);
+			counter->shown[i] = c;
+		}
+	}
+}
+
+/********************************************************************************
+*                                                                               *
+* FUNCTION NAME: Counter_Redraw		                                              *
+*                                                                               *
+* PURPOSE: Draw again every character shown, after the field was painted over	*
+* ARGUMENT LIST:                                                                *
+*                                                                               *
+* Argument  Type         IO     Description                                     *
+* --------- --------     --     ---------------------------------               *
+* counter		Counter*		 I			Counter to redraw																*
+*																																								*
+* RETURN VALUE: void                                                            *
+*                                                                               *
+********************************************************************************/
+void Counter_Redraw(Counter *counter)
+{
+	uint8_t i;
+
+	for(i = 0; i < counter->digits; i++)
+	{
+		if(counter->shown[i] != 0)
+		{
+			DrawDigit(counter, i, counter->shown[i]);
+		}
+	}
+}
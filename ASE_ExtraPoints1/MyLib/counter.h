@@ -0,0 +1,27 @@
+#include "LPC17xx.H"                    /* LPC17xx definitions                */
+#include "../GLCD/GLCD.h"
+
+#ifndef __COUNTER_H
+#define __COUNTER_H
+
+/* Maximum number of characters of a counter */
+#define COUNTER_MAX_DIGITS	6
+
+/* Counter flags */
+#define COUNTER_RIGHT			0x01		/* right aligned, blanks on the left						*/
+#define COUNTER_ROTATED		0x02		/* upside down, read from the other side of the board */
+
+/* A number on the screen that remembers what it shows */
+typedef struct {
+	uint16_t x, y;												/* top-left corner of the field					*/
+	uint8_t digits;												/* width of the field, in characters		*/
+	uint8_t flags;												/* COUNTER_RIGHT, COUNTER_ROTATED				*/
+	uint16_t color, bkColor;
+	char shown[COUNTER_MAX_DIGITS];				/* characters on the screen, 0 if unknown	*/
+} Counter;
+
+void Counter_Init(Counter *counter, uint16_t x, uint16_t y, uint8_t digits, uint8_t flags, uint16_t color, uint16_t bkColor);
+void Counter_Show(Counter *counter, uint32_t value);
+void Counter_Redraw(Counter *counter);
+
+#endif
@@ -0,0 +1,96 @@
+#include "events.h"
+#include "../systick/systick.h"
+
+/* The loop reads at ev_tail, the interrupts write at ev_head: both only grow */
+static volatile Event ring[EVENT_QUEUE];
+static volatile uint32_t ev_head = 0, ev_tail = 0;
+
+volatile uint32_t events_lost = 0;
+
+/********************************************************************************
+*                                                                               *
+* FUNCTION NAME: Event_Post				                                              *
+*                                                                               *
+* PURPOSE: Post an event with the time, interrupts only													*
+* ARGUMENT LIST:																																*
+*                                                                               *
+* Argument  Type         IO     Description																			*
+* --------- --------     --     ---------------------------------								*
+* kind			uint16_t		 I			EV_																							*
+* data			uint16_t		 I			Input or sample																	*
+*																																								*
+* RETURN VALUE: int, 0 if the ring is full and the event is lost                *
+*                                                                               *
+********************************************************************************/
+int Event_Post(uint16_t kind, uint16_t data)
+{
+	return Event_PostAt(kind, data, read_SysTick_us());
+}
+
+/********************************************************************************
+*                                                                               *
+* FUNCTION NAME: Event_PostAt																										*
+*                                                                               *
+* PURPOSE: Post an event that happened at time, interrupts only. The event is		*
+*					 written before the head moves past it, so the loop never reads it		*
+*					 half done																														*
+* ARGUMENT LIST:																																*
+*                                                                               *
+* Argument  Type         IO     Description																			*
+* --------- --------     --     ---------------------------------								*
+* kind			uint16_t		 I			EV_																							*
+* data			uint16_t		 I			Input or sample																	*
+* time			uint32_t		 I			us from read_SysTick_us													*
+*																																								*
+* RETURN VALUE: int, 0 if the ring is full and the event is lost                *
+*                                                                               *
+********************************************************************************/
+int Event_PostAt(uint16_t kind, uint16_t data, uint32_t time)
+{
+	uint32_t head = ev_head;
+	volatile Event *ev;
+	
+	if(head - ev_tail == EVENT_QUEUE)
+	{
+		events_lost++;
+		return 0;
+	}
+	ev = &ring[head % EVENT_QUEUE];
+	ev->time = time;
+	ev->kind = kind;
+	ev->data = data;
+	ev_head = head + 1;
+	return 1;
+}
+
+/********************************************************************************
+*                                                                               *
+* FUNCTION NAME: Event_Get				                                              *
+*                                                                               *
+* PURPOSE: Take the oldest event out of the ring, loop in main only. The slot		*
+*					 is copied before the tail moves past it and frees it									*
+* ARGUMENT LIST:																																*
+*                                                                               *
+* Argument  Type         IO     Description																			*
+* --------- --------     --     ---------------------------------								*
+* ev				Event*			 O			The event																				*
+*																																								*
+* RETURN VALUE: int, 0 if there is no event                                     *
+*                                                                               *
+********************************************************************************/
+int Event_Get(Event *ev)
+{
+	uint32_t tail = ev_tail;
+	volatile Event *slot;
+	
+	if(tail == ev_head)
+	{
+		return 0;
+	}
+	slot = &ring[tail % EVENT_QUEUE];
+	ev->time = slot->time;
+	ev->kind = slot->kind;
+	ev->data = slot->data;
+	ev_tail = tail + 1;
+	return 1;
+}
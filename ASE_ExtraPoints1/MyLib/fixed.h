@@ -0,0 +1,17 @@
+#include <stdint.h>
+
+#ifndef __FIXED_H
+#define __FIXED_H
+
+/* Q16.16 fixed point: 16 integer bits and 16 fraction bits, no float on the M3 */
+typedef int32_t fix16_t;
+
+#define FIX_SHIFT				16
+#define FIX_ONE					((fix16_t)1 << FIX_SHIFT)
+
+#define FIX(n)					((fix16_t)((n) * FIX_ONE))
+#define FIX_INT(f)			((int32_t)((f) >> FIX_SHIFT))		/* rounds towards -inf */
+#define FIX_MUL(a, b)		((fix16_t)(((int64_t)(a) * (b)) >> FIX_SHIFT))
+#define FIX_DIV(a, b)		((fix16_t)((int64_t)(a) * FIX_ONE / (b)))
+
+#endif
@@ -1,33 +1,32 @@
 #include "functs.h"
-#include "../timer/timer.h"
+#include "../dac/dac.h"
+#include "sound.h"
+#include "events.h"
+#include "../input/input.h"
+#include "recorder.h"
 
 /* Potentiometer edge positions */
 #define MIN_POT 6
 #define MAX_POT MAX_X - 6
 
-/* Ball edge positions on both axis */
-#define MIN_BALLX 6
-#define MAX_BALLX MAX_X - 6
+/* State of the board, changed by the buttons and by the end of a game */
+int start = 0;			/* a game is on											*/
+int stop = 0;				/* the game is paused with KEY2			*/
+int reset = 0;			/* a game was lost, INT0 clears it	*/
 
-#define MIN_BALLY 6
-#define MAX_BALLY MAX_Y - 33
+/* Pixels the scene may repaint in a single frame */
+#define SCENE_BUDGET 2048
 
-/* Defined in the RIT timer library */
-extern int start, reset, stop;
+/* Objects of the scene, bottom to top */
+static SceneObject left_wall, right_wall, top_wall;
+static SceneObject score_obj, record_obj;
 
-/* Defined in the adc library */
-extern uint16_t adc_Xposition, adc_Yposition;
+/* The choices of the next game are on the start screen */
+static int choice_shown = 0;
 
-/* Old position of the ball */
-uint16_t x_old = MAX_X - 6;
-uint16_t y_old = MAX_Y / 2;
-
-/* Actual position of the ball */
-uint16_t ball_Xpos;
-uint16_t ball_Ypos;
-
-int score = 0;
-int record = 100;
+/* Score and record on the screen */
+static Counter score_counter, record_counter;
+Sprite paddle_sprite, ball_sprites[BALL_POOL];
 
 
 /********************************************************************************
@@ -45,67 +44,56 @@ int record = 100;
 ********************************************************************************/
 void DrawLateralLines()
 {
-	size_t i;
-	
-	for(i = 0; i < 5; i++)
-	{
-		LCD_DrawLine(i, 0, i, adc_Yposition, Red);
-		LCD_DrawLine(0, i, MAX_X - 1, i, Red);
-		LCD_DrawLine(MAX_X - 1 - i, 0, MAX_X - 1 - i, adc_Yposition, Red);
-	}
+	LCD_FillRect(0, 0, 5, game.paddle_y + 1, Red);
+	LCD_FillRect(0, 0, MAX_X, 5, Red);
+	LCD_FillRect(MAX_X - 5, 0, 5, game.paddle_y + 1, Red);
 }
 
 /********************************************************************************
 *                                                                               *
-* FUNCTION NAME: LCD_PutInt				                                              *
+* FUNCTION NAME: PaintCounter		                                              *
 *                                                                               *
-* PURPOSE: Print a number on the LCD																						*
+* PURPOSE: Scene painter for the score and the record														*
 * ARGUMENT LIST:                                                                *
 *                                                                               *
 * Argument  Type         IO     Description                                     *
 * --------- --------     --     ---------------------------------               *
-* Xpos			uint16_t		 I			Initial X position															*
-*	Ypos			uint16_t		 I			Initial Y position															*
-*	number		int					 I			Number to print on the LCD											*
-*	charColor	uint16_t		 I			Color to print the number												*
-*	bkColor		uint16_t		 I			Color to print the background										*
+* obj				SceneObject* I			Object to paint																	*
 *																																								*
 * RETURN VALUE: void                                                            *
 *                                                                               *
 ********************************************************************************/
-void LCD_PutInt(uint16_t Xpos, uint16_t Ypos, int number, uint16_t charColor, uint16_t bkColor)
+static void PaintCounter(const SceneObject *obj)
 {
-		char ascii[8];
-		sprintf(ascii,"%d",number);
-		if(number < 10)
-		{
-			PutChar(Xpos, Ypos, ascii[0], charColor, bkColor);
-		}
-		else if(number < 100)
-		{
-			PutChar(Xpos, Ypos, ascii[0], charColor, bkColor);
-			PutChar(Xpos + 9, Ypos, ascii[1], charColor, bkColor);
-		}
-		else if(number < 1000)
-		{
-			PutChar(Xpos, Ypos, ascii[0], charColor, bkColor);
-			PutChar(Xpos + 9, Ypos, ascii[1], charColor, bkColor);
-			PutChar(Xpos + 18, Ypos, ascii[2], charColor, bkColor);
-		}
-		else if(number < 10000)
-		{
-			PutChar(Xpos, Ypos, ascii[0], charColor, bkColor);
-			PutChar(Xpos + 9, Ypos, ascii[1], charColor, bkColor);
-			PutChar(Xpos + 18, Ypos, ascii[2], charColor, bkColor);
-			PutChar(Xpos + 27, Ypos, ascii[3], charColor, bkColor);
-		}
+	Counter_Redraw((Counter *)obj->data);
+}
+
+static void AddObject(SceneObject *obj, uint16_t x, uint16_t y, uint16_t w, uint16_t h, uint16_t color)
+{
+	obj->x = x;
+	obj->y = y;
+	obj->w = w;
+	obj->h = h;
+	obj->color = color;
+	obj->paint = NULL;
+	obj->data = NULL;
+	Scene_Add(obj);
+}
+
+static void AddSprite(Sprite *sprite, uint16_t x, uint16_t y, uint16_t w, uint16_t h)
+{
+	Sprite_Init(sprite, x, y, w, h, Green, NULL);
+	sprite->uncover = Scene_Invalidate;
+	Scene_Add(&sprite->obj);
 }
 
 /********************************************************************************
 *                                                                               *
-* FUNCTION NAME: IncrementScore		                                              *
+* FUNCTION NAME: InitScene				                                              *
 *                                                                               *
-* PURPOSE: Increment the score of the game																			*
+* PURPOSE: Describe the game field to the scene, which repaints whatever				*
+*					 the ball uncovers, and show the score and the record.								*
+*					 The rest of the field must already be drawn													*
 * ARGUMENT LIST:                                                                *
 *                                                                               *
 * Argument  Type         IO     Description                                     *
@@ -114,26 +102,63 @@ void LCD_PutInt(uint16_t Xpos, uint16_t Ypos, int number, uint16_t charColor, ui
 * RETURN VALUE: void                                                            *
 *                                                                               *
 ********************************************************************************/
-void IncrementScore()
+void InitScene()
 {
-	if(score >= 100)
-	{
-		score += 10;
-		record = score;
-		LCD_PutInt(MAX_X - 35, 6, record, White, Black);
-	}
-	else
+	int i;
+	
+	Scene_Init(Black, SCENE_BUDGET);
+	AddObject(&left_wall, 0, 0, 5, game.paddle_y + 1, Red);
+	AddObject(&top_wall, 0, 0, MAX_X, 5, Red);
+	AddObject(&right_wall, MAX_X - 5, 0, 5, game.paddle_y + 1, Red);
+	/* The record is right aligned against the right wall */
+	Counter_Init(&score_counter, 6, MAX_Y / 2, 4, 0, White, Black);
+	Counter_Init(&record_counter, MAX_X - 38, 6, 4, COUNTER_RIGHT, White, Black);
+	AddObject(&score_obj, 6, MAX_Y / 2, 32, 16, White);
+	score_obj.paint = PaintCounter;
+	score_obj.data = &score_counter;
+	AddObject(&record_obj, MAX_X - 38, 6, 32, 16, White);
+	record_obj.paint = PaintCounter;
+	record_obj.data = &record_counter;
+	AddSprite(&paddle_sprite, game.paddle_x, game.paddle_y, 40, 11);
+	/* The balls are hidden until ShowBalls draws those in play */
+	for(i = 0; i < BALL_POOL; i++)
 	{
-		score += 5;
+		AddSprite(&ball_sprites[i], 0, 0, 0, 0);
 	}
-	LCD_PutInt(6, MAX_Y / 2, score, White, Black);
+
+	Counter_Show(&score_counter, game.score);
+	Counter_Show(&record_counter, game.record);
+}
+
+/********************************************************************************
+*                                                                               *
+* FUNCTION NAME: ShowBalls				                                              *
+*                                                                               *
+* PURPOSE: Draw the balls in play, on a scene just made by InitScene						*
+* ARGUMENT LIST:                                                                *
+*                                                                               *
+* Argument  Type         IO     Description                                     *
+* --------- --------     --     ---------------------------------               *
+*                                                                               *
+* RETURN VALUE: void                                                            *
+*                                                                               *
+********************************************************************************/
+void ShowBalls()
+{
+		int i;
+		
+		for(i = 0; i < game.balls.count; i++)
+		{
+			Sprite_Show(&ball_sprites[i], Pool_Left(&game.balls, i), Pool_Top(&game.balls, i), game.balls.size, game.balls.size);
+		}
+		Scene_Render();
 }
 
 /********************************************************************************
 *                                                                               *
 * FUNCTION NAME: InitBall					                                              *
 *                                                                               *
-* PURPOSE: Initialize the ball's position																				*
+* PURPOSE: Serve the balls and draw them																				*
 * ARGUMENT LIST:                                                                *
 *                                                                               *
 * Argument  Type         IO     Description                                     *
@@ -144,29 +169,59 @@ void IncrementScore()
 ********************************************************************************/
 void InitBall()
 {
-		size_t i;
-	
-		ball_Xpos = MAX_X - 6;
-		ball_Ypos = MAX_Y / 2;
+		Game_Serve();
+		ShowBalls();
+}
+
+/********************************************************************************
+*                                                                               *
+* FUNCTION NAME: PlayGame					                                              *
+*                                                                               *
+* PURPOSE: One fixed step of the game on the last ADC sample, with its				*
+*					 sounds. Only the score and the messages are drawn here								*
+* ARGUMENT LIST:                                                                *
+*                                                                               *
+* Argument  Type         IO     Description                                     *
+* --------- --------     --     ---------------------------------               *
+* sample		uint16_t		 I			ADC sample published to the loop								*
+*																																								*
+* RETURN VALUE: the GAME_* events of the step                                   *
+*                                                                               *
+********************************************************************************/
+uint32_t PlayGame(uint16_t sample)
+{
+	uint32_t events = Game_Step(sample);
+	uint16_t effect = SOUND_NONE;
 	
-		for(i = 0; i < 5; i++)
+	if(events & GAME_HIT)
+	{
+		effect = (events & GAME_RECORD) ? SOUND_SCORE : SOUND_PADDLE;
+		Counter_Show(&score_counter, game.score);
+		if(events & GAME_RECORD)
 		{
-			LCD_DrawLine(x_old - 4, y_old - i, x_old, y_old - i, Black);
-			LCD_DrawLine(ball_Xpos - 4, ball_Ypos - i, ball_Xpos, ball_Ypos - i,Green);
+			Counter_Show(&record_counter, game.record);
 		}
-	
-		x_old = MAX_X - 6;
-		y_old = MAX_Y / 2;
-		ball_Xpos -=1;
-		ball_Ypos +=1;
+	}
+	else if(events & (GAME_BOUNCE | GAME_MISS))
+	{
+		effect = SOUND_WALL;
+	}
+	if(events & GAME_OVER)
+	{
+		effect = SOUND_LOSE;
+		GameLost();
+	}
+	/* One sound per step, the queue merges the ones that come too fast */
+	Sound_Play(effect);
+	return events;
 }
 
 /********************************************************************************
 *                                                                               *
-* FUNCTION NAME: MoveBall					                                              *
+* FUNCTION NAME: RenderGame				                                              *
 *                                                                               *
-* PURPOSE: Function to calculate the next ball's position based on							*
-*						where the current position is																				*
+* PURPOSE: Draw the sprites where the last steps left them: only the pixels	*
+*					 that change are drawn, the scene repaints what the sprites leave		*
 * ARGUMENT LIST:                                                                *
 *                                                                               *
 * Argument  Type         IO     Description                                     *
@@ -175,157 +230,22 @@ void InitBall()
 * RETURN VALUE: void                                                            *
 *                                                                               *
 ********************************************************************************/
-void MoveBall()
+void RenderGame()
 {
-		
-	  static uint16_t x_new, y_new;
-		static uint16_t adc_Xold;
-		static int speed;
-		size_t i;
-		for(i = 0; i < 5; i++)
-		{
-			/* Delete previous ball */
-			LCD_DrawLine(x_old - i, y_old - 4, x_old - i, y_old, Black);
-		}
-		for(i = 0; i < 5; i++)
-		{
-			/* Draw the ball */
-			LCD_DrawLine(ball_Xpos - i, ball_Ypos - 4, ball_Xpos - i, ball_Ypos, Green);
-		}
-		
-		/* Calculate next position */
-		if(ball_Xpos >= MAX_BALLX || (ball_Xpos - 4) <= MIN_BALLX || 
-			((ball_Ypos < (adc_Yposition - 4 && (ball_Ypos - 4) > adc_Yposition)) 
-			&& (ball_Xpos == (adc_Xposition + 40) || (ball_Xpos - 4) == adc_Xposition)))
-		{
-			/* If the ball's in one of the two top edges */
-			if(ball_Ypos - 4 <= MIN_BALLY)
-			{
-				x_new = x_old;
-				y_new = y_old;
-				disable_timer(0);
-				reset_timer(0);
-				init_timer(0,1263);
-				enable_timer(0);
-			}
-			/* If the ball is on one of the two potentiometer top angles */
-			else if(ball_Xpos == adc_Xposition && (ball_Ypos == (adc_Yposition - 4 || (ball_Ypos - 4) == adc_Yposition)))
-			{
-				x_new = x_old;
-				y_new = y_old;
-				IncrementScore();
-				disable_timer(0);
-				reset_timer(0);
-				init_timer(0,1062);
-				enable_timer(0);
-			}
-			/* If the ball's on one of the two lateral walls or on the side of the paddle*/
-			else
-			{
-				x_new = x_old;
-				y_new = 2 * ball_Ypos - y_old;
-				disable_timer(0);
-				reset_timer(0);
-				init_timer(0,1263);
-				enable_timer(0);
-			}
-			
-			
-		}
-		else if(ball_Ypos - 4 <= MIN_BALLY)
-		{
-			x_new = 2 * ball_Xpos - x_old;
-			y_new = y_old;
-			/* Low pitch tone */
-			disable_timer(0);
-			reset_timer(0);
-			init_timer(0,1263);
-			enable_timer(0);
-		}
-		/* if the ball is touching the top of the paddle */
-		else if((ball_Ypos == adc_Yposition - 4) && (ball_Xpos > adc_Xposition && (ball_Xpos - 4) < (adc_Xposition + 40)))
-		{
-			/* 
-			 * The next position varies on the speed of the paddle, 
-			 * calculated using its previous and next position 
-			 */
-			speed = (int)(adc_Xposition - adc_Xold);
-			x_new = (2 * ball_Xpos - x_old);
-			y_new = y_old;
-			
-			if((int)(ball_Xpos - x_old) < 0)
-			{
-				y_new = (y_new - 1 == y_old) ? y_new : y_new - 1;
-			}
-			else if((int)(ball_Xpos - x_old) > 0)
-			{
-				if(speed > 0)
-				{
-					x_new = (x_new + 1 == x_old) ? x_new : x_new + 1;
-				}
-				else
-				{
-					x_new = (x_new - 1 == x_old) ? x_new : x_new - 1;
-				}
-			}
-			
-			IncrementScore();
-			disable_timer(0);
-			reset_timer(0);
-			init_timer(0,1062);
-			enable_timer(0);
-		}
-		/* In each other case, when the ball is in the middle of the display */
-		else
-		{
-			x_new = 2 * ball_Xpos - x_old;
-			y_new = 2 * ball_Ypos - y_old;
-		}
-		
-		/* Just to be sure that the number is still visible */
-		if(ball_Xpos < 27 && (ball_Ypos < MAX_Y / 2 && ball_Xpos > MAX_Y / 2 + 9))
-		{
-			LCD_PutInt(6, MAX_Y / 2, score, White, Black);
-		}
-		else if((ball_Xpos > MAX_X - 35 && ball_Xpos < MAX_X - 6) && (ball_Ypos > 5 && ball_Ypos  < 14))
-		{
-			LCD_PutInt(MAX_X - 35, 6, record, White, Black);
-		}			
-		/* Just to keep the integrity of the game environment */
-		if(x_old <= MIN_BALLX)
-		{
-			for(i = 0; i < 5; i++)
-			{
-				LCD_DrawLine(i, 0, i, adc_Yposition, Red);
-			}
-		}
-		else if(x_old >= MAX_BALLX)
-		{
-			for(i = 0; i < 5; i++)
-			{
-				LCD_DrawLine(MAX_X - 1 - i, 0, MAX_X - 1 - i, adc_Yposition, Red);
-			}
-		}
-		else if(y_old - 4 < MIN_BALLY)
-		{
-			for(i = 0; i < 5; i++)
-			{
-				LCD_DrawLine(0, i, MAX_X - 1, i, Red);
-			}
-		}
-		
-		/* Update the values */
-		x_old = ball_Xpos;
-		y_old = ball_Ypos;
-		ball_Xpos = x_new;
-		ball_Ypos = y_new;
-		adc_Xold = adc_Xposition;
-		
-		/* If the position is lower than the end of the paddle, than it's game over */
-		if(ball_Ypos - 4 > MAX_BALLY)
-		{
-			GameLost();
-		}
+	const BallPool *balls = &game.balls;
+	int i;
+	
+	Sprite_MoveTo(&paddle_sprite, game.paddle_x, game.paddle_y);
+	for(i = 0; i < balls->count; i++)
+	{
+		Sprite_MoveTo(&ball_sprites[i], Pool_Left(balls, i), Pool_Top(balls, i));
+	}
+	/* The sprites past the balls in play are those of the balls that went out */
+	for(; i < BALL_POOL; i++)
+	{
+		Sprite_Hide(&ball_sprites[i]);
+	}
+	Scene_Render();
 }
 
 /********************************************************************************
@@ -352,10 +272,127 @@ void GameLost()
 			reset = 1;
 			start = 0;
 			GUI_Text(MAX_X/2 - 50, MAX_Y / 2, "You Lose", White, Black);
-			disable_timer(0);
-			reset_timer(0);
-			init_timer(0,2048);
-			enable_timer(0);
 			GUI_Text(MAX_X/2 - 100, MAX_Y / 2 + 15, "Press INT0 to Reset", White, Black);
-			NVIC_EnableIRQ(EINT0_IRQn);
+			GUI_Text(MAX_X/2 - 100, MAX_Y / 2 + 30, "Press KEY2 to Replay", White, Black);
+}
+
+/********************************************************************************
+*                                                                               *
+* FUNCTION NAME: PressButton			                                              *
+*                                                                               *
+* PURPOSE: What a button does in the state of the board, called by the loop			*
+*					 in main for the EV_PRESS events. A button that has nothing to do			*
+*					 is ignored																														*
+* ARGUMENT LIST:                                                                *
+*                                                                               *
+* Argument  Type         IO     Description                                     *
+* --------- --------     --     ---------------------------------               *
+* button		uint16_t		 I			IN_INT0, IN_KEY1 or IN_KEY2											*
+*																																								*
+* RETURN VALUE: the PRESS_* outcome                                             *
+*                                                                               *
+********************************************************************************/
+uint32_t PressButton(uint16_t button)
+{
+	switch(button)
+	{
+		case IN_INT0:
+			/* After a lost game INT0 clears the screen for a new one */
+			if(reset == 1 && start == 0)
+			{
+				reset = 0;
+				LCD_Clear(Black);
+				GUI_Text(MAX_X / 2 - 100, MAX_Y / 2, "Press KEY1 to Restart", White, Black);
+				choice_shown = 0;
+				return PRESS_RESET;
+			}
+			break;
+		case IN_KEY1:
+			/* At the beginning or after INT0 KEY1 starts a new game */
+			if(reset == 0 && start == 0)
+			{
+				Game_Start();
+				GUI_Text(MAX_X / 2 - 100, MAX_Y / 2, "Press KEY1 to Start  ", Black, Black);
+				LCD_FillRect(0, MAX_Y / 2 + 24, MAX_X, 16, Black);
+				choice_shown = 0;
+				DrawLateralLines();
+				/* Init Paddle position */
+				LCD_FillRect(game.paddle_x, game.paddle_y, 40, 11, Green);
+				InitScene();
+				InitBall();
+				start = 1;
+				stop = 0;
+				return PRESS_START;
+			}
+			break;
+		case IN_KEY2:
+			/* While a game is on KEY2 pauses it and resumes it */
+			if(start == 1)
+			{
+				stop = !stop;
+				return PRESS_PAUSE;
+			}
+			/* After a lost game the game is played again from its recording, where it started */
+			if(reset == 1 && Replay_Start())
+			{
+				reset = 0;
+				LCD_Clear(Black);
+				DrawLateralLines();
+				LCD_FillRect(game.paddle_x, game.paddle_y, 40, 11, Green);
+				InitScene();
+				ShowBalls();
+				start = 1;
+				stop = 0;
+				return PRESS_REPLAY;
+			}
+			break;
+		default:
+			break;
+	}
+	return PRESS_NONE;
+}
+
+/********************************************************************************
+*                                                                               *
+* FUNCTION NAME: ChooseGame				                                              *
+*                                                                               *
+* PURPOSE: The choices of the next game, on the start screen only: the					*
+*					 joystick up and down change the balls of a serve. Drawn when they		*
+*					 change or the screen was cleared																			*
+* ARGUMENT LIST:                                                                *
+*                                                                               *
+* Argument  Type         IO     Description                                     *
+* --------- --------     --     ---------------------------------               *
+* pressed		uint16_t		 I			Bits 1 << IN_* of the inputs down since the			*
+*														last call																				*
+*																																								*
+* RETURN VALUE: void                                                            *
+*                                                                               *
+********************************************************************************/
+void ChooseGame(uint16_t pressed)
+{
+	uint16_t balls = game.served;
+	uint8_t count[2];
+	
+	if(start == 1 || reset == 1)
+	{
+		return;
+	}
+	if((pressed & (1 << IN_UP)) && balls < BALL_POOL)
+	{
+		balls++;
+	}
+	if((pressed & (1 << IN_DOWN)) && balls > 1)
+	{
+		balls--;
+	}
+	if(balls != game.served || !choice_shown)
+	{
+		Game_SetBalls(balls);
+		count[0] = '0' + balls;
+		count[1] = 0;
+		GUI_Text(MAX_X / 2 - 100, MAX_Y / 2 + 24, "Balls (up/down):", White, Black);
+		GUI_Text(MAX_X / 2 + 44, MAX_Y / 2 + 24, count, White, Black);
+		choice_shown = 1;
+	}
 }
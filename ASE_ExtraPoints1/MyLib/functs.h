@@ -1,15 +1,34 @@
-#include <stdio.h>
 #include "LPC17xx.H"                    /* LPC17xx definitions                */
 #include "../GLCD/GLCD.h" 
 #include "../TouchPanel/TouchPanel.h"
 #include "../led/led.h"
 #include "../adc/adc.h"
+#include "scene.h"
+#include "sprite.h"
+#include "counter.h"
+#include "game.h"
+
+/* Sprites of the game, defined in functs.c */
+extern Sprite paddle_sprite, ball_sprites[BALL_POOL];
+
+/* State of the board, defined in functs.c and changed by the loop in main only */
+extern int start, stop, reset;
+
+/* What a button press did, for the game loop */
+#define PRESS_NONE		0
+#define PRESS_START		1			/* KEY1 started a new game						*/
+#define PRESS_REPLAY	2			/* KEY2 started the last game again		*/
+#define PRESS_PAUSE		3			/* KEY2 paused or resumed the game		*/
+#define PRESS_RESET		4			/* INT0 cleared the lost game					*/
 
 uint32_t ASCIItoUnsig(uint8_t *str, uint32_t size);
 void InitBall(void);
-void MoveBall(void);
+void ShowBalls(void);
 void GameLost(void);
-void LCD_PutInt(uint16_t Xpos, uint16_t Ypos, int number, uint16_t charColor, uint16_t bkColor);
-void PlayGame(void);
+uint32_t PlayGame(uint16_t sample);
+void RenderGame(void);
 void GameLost(void);
 void DrawLateralLines(void);
+uint32_t PressButton(uint16_t button);
+void ChooseGame(uint16_t pressed);
+void InitScene(void);
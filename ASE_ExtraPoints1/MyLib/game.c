@@ -0,0 +1,352 @@
+#include "game.h"
+
+/* The first ball starts at the right wall, the record to beat is 100 */
+GameState game = {
+	{{FIX(MAX_X - 10)}, {FIX(MAX_Y / 2 - 4)}, {0}, {0}, {FIX_ONE}, 1, 5},
+	0, 100,
+	MAX_X / 2 - 20, MAX_Y - 33,
+	0, 0xFF,
+	GAME_BALLS, 0
+};
+
+/* Obstacles of the ball, rebuilt at every step where the paddle is */
+enum { LEFT_WALL, RIGHT_WALL, TOP_WALL, PADDLE, OBSTACLES };
+static Box obstacles[OBSTACLES];
+static int16_t paddle_spin;		/* -1, 0 or 1 as the paddle moves */
+
+/* GAME_* events of the current step */
+static uint32_t events;
+
+
+/********************************************************************************
+*                                                                               *
+* FUNCTION NAME: MovePaddle				                                              *
+*                                                                               *
+* PURPOSE: Move the paddle where the potentiometer is: [-  ] to [  -],					*
+*					 clockwise. adc/ filters the sample, half a pixel of hysteresis				*
+*					 keeps it still between two pixels: there is no dead-band							*
+* ARGUMENT LIST:                                                                *
+*                                                                               *
+* Argument  Type         IO     Description                                     *
+* --------- --------     --     ---------------------------------               *
+* sample		uint16_t		 I			Last ADC sample																	*
+*																																								*
+* RETURN VALUE: void                                                            *
+*                                                                               *
+********************************************************************************/
+static void MovePaddle(uint16_t sample)
+{
+	int32_t q;
+	
+	if(sample == game.last_sample)
+	{
+		return;
+	}
+	game.last_sample = sample;
+	
+	if(sample <= MIN_PADDLE)
+	{
+		game.paddle_x = 6;
+		return;
+	}
+	if(sample >= MAX_PADDLE)
+	{
+		game.paddle_x = MAX_X - 46;
+		return;
+	}
+	/* Same run as the clamped ends, in quarters of a pixel: the paddle must not reach the right wall */
+	q = (int32_t)(sample - MIN_PADDLE) * (MAX_X - 52) * 4 / (MAX_PADDLE - MIN_PADDLE) + 6 * 4;
+	/* Half a pixel past the edges of the one it is on: a knob between two does not flicker */
+	if(q >= game.paddle_x * 4 + 6 || q <= game.paddle_x * 4 - 3)
+	{
+		game.paddle_x = (uint16_t)(q / 4);
+	}
+}
+
+/********************************************************************************
+*                                                                               *
+* FUNCTION NAME: IncrementScore		                                              *
+*                                                                               *
+* PURPOSE: Increment the game.score of the game																			*
+* ARGUMENT LIST:                                                                *
+*                                                                               *
+* Argument  Type         IO     Description                                     *
+* --------- --------     --     ---------------------------------               *
+*                                                                               *
+* RETURN VALUE: void                                                            *
+*                                                                               *
+********************************************************************************/
+static void IncrementScore()
+{
+	if(game.score >= 100)
+	{
+		game.score += 10;
+	}
+	else
+	{
+		game.score += 5;
+	}
+	/* A short game after a long one must not lower the game.record */
+	if(game.score > game.record)
+	{
+		game.record = game.score;
+		events |= GAME_RECORD;
+	}
+}
+
+/********************************************************************************
+*                                                                               *
+* FUNCTION NAME: SetBox						                                              *
+*                                                                               *
+* PURPOSE: Place an obstacle of the ball																				*
+* ARGUMENT LIST:                                                                *
+*                                                                               *
+* Argument  Type         IO     Description                                     *
+* --------- --------     --     ---------------------------------               *
+* box				Box*				 O			Obstacle																				*
+*	x, y			int16_t			 I			Top-left corner, in px													*
+*	w, h			int16_t			 I			Size, in px																			*
+*																																								*
+* RETURN VALUE: void                                                            *
+*                                                                               *
+********************************************************************************/
+static void SetBox(Box *box, int16_t x, int16_t y, int16_t w, int16_t h)
+{
+	box->x = FIX(x);
+	box->y = FIX(y);
+	box->w = FIX(w);
+	box->h = FIX(h);
+}
+
+/********************************************************************************
+*                                                                               *
+* FUNCTION NAME: Bounce						                                              *
+*                                                                               *
+* PURPOSE: What a ball does when it hits an obstacle: the flat face of a				*
+*					 paddle sends it back with an angle that depends on where it hits,		*
+*					 anything else reflects it																						*
+* ARGUMENT LIST:                                                                *
+*                                                                               *
+* Argument  Type         IO     Description                                     *
+* --------- --------     --     ---------------------------------               *
+* b					Ball*				 I/O		The ball, on the face it hit										*
+* index			int					 I			Obstacle hit																		*
+* hit				Hit*				 I			Contact																					*
+*																																								*
+* RETURN VALUE: void                                                            *
+*                                                                               *
+********************************************************************************/
+static void Bounce(Ball *b, int index, const Hit *hit)
+{
+	if(index == PADDLE && hit->ny < 0)
+	{
+		Ball_Deflect(b, Ball_Left(b) + 2 - (game.paddle_x + 20), 22, paddle_spin, -1);
+		Ball_SpeedUp(b);
+		IncrementScore();
+		events |= GAME_HIT;
+	}
+	else
+	{
+		Ball_Reflect(b, hit);
+		events |= GAME_BOUNCE;
+	}
+}
+
+/********************************************************************************
+*                                                                               *
+* FUNCTION NAME: MoveBalls				                                              *
+*                                                                               *
+* PURPOSE: Move every ball in play by one step. A ball lower than the end of		*
+*					 the paddle is out, the game is over when the last one is							*
+* ARGUMENT LIST:                                                                *
+*                                                                               *
+* Argument  Type         IO     Description                                     *
+* --------- --------     --     ---------------------------------               *
+*                                                                               *
+* RETURN VALUE: void                                                            *
+*                                                                               *
+********************************************************************************/
+static void MoveBalls()
+{
+		BallPool *balls = &game.balls;
+		int i;
+		
+		paddle_spin = game.paddle_x > game.paddle_old ? 1 : game.paddle_x < game.paddle_old ? -1 : 0;
+		
+		/* The walls keep the balls in [MIN_BALLX, MAX_BALLX] and below MIN_BALLY */
+		SetBox(&obstacles[LEFT_WALL], MIN_BALLX - 16, -MAX_Y, 16, 3 * MAX_Y);
+		SetBox(&obstacles[RIGHT_WALL], MAX_BALLX + 1, -MAX_Y, 16, 3 * MAX_Y);
+		SetBox(&obstacles[TOP_WALL], -MAX_X, MIN_BALLY - 16, 3 * MAX_X, 16);
+		SetBox(&obstacles[PADDLE], game.paddle_x, game.paddle_y, 40, 11);
+		Pool_Move(balls, obstacles, OBSTACLES, Bounce);
+		game.paddle_old = game.paddle_x;
+		
+		/* Backwards: the last ball takes the place of the one that is out */
+		for(i = balls->count - 1; i >= 0; i--)
+		{
+			if(Pool_Bottom(balls, i) - 4 > MAX_BALLY)
+			{
+				Pool_Remove(balls, i);
+				game.lost++;
+				events |= GAME_MISS;
+			}
+		}
+		if(balls->count == 0)
+		{
+			events = (events & ~GAME_MISS) | GAME_OVER;
+		}
+}
+
+/********************************************************************************
+*                                                                               *
+* FUNCTION NAME: Game_Start				                                              *
+*                                                                               *
+* PURPOSE: Start a new game from a zero game.score, the game.record is kept								*
+* ARGUMENT LIST:                                                                *
+*                                                                               *
+* Argument  Type         IO     Description                                     *
+* --------- --------     --     ---------------------------------               *
+*                                                                               *
+* RETURN VALUE: void                                                            *
+*                                                                               *
+********************************************************************************/
+void Game_Start()
+{
+	game.score = 0;
+	game.lost = 0;
+}
+
+/********************************************************************************
+*                                                                               *
+* FUNCTION NAME: Game_Serve				                                              *
+*                                                                               *
+* PURPOSE: Put the balls of a serve in play, at speed 1													*
+* ARGUMENT LIST:                                                                *
+*                                                                               *
+* Argument  Type         IO     Description                                     *
+* --------- --------     --     ---------------------------------               *
+*                                                                               *
+* RETURN VALUE: void                                                            *
+*                                                                               *
+********************************************************************************/
+void Game_Serve()
+{
+	Ball ball;
+	int i;
+	
+	/* The first ball leaves the right wall towards the bottom left, the others
+	 * follow it to the left and higher up, every other one towards the right */
+	Pool_Init(&game.balls, 5);
+	for(i = 0; i < game.served; i++)
+	{
+		Ball_Init(&ball, MAX_BALLX - 4 - 28 * i, MAX_Y / 2 - 4 - 12 * i, 5, (i & 1) ? FIX_ONE : -FIX_ONE, FIX_ONE);
+		Pool_Add(&game.balls, &ball);
+	}
+}
+
+/********************************************************************************
+*                                                                               *
+* FUNCTION NAME: Game_SetBalls		                                              *
+*                                                                               *
+* PURPOSE: Choose how many balls the next serves put in play										*
+* ARGUMENT LIST:                                                                *
+*                                                                               *
+* Argument  Type         IO     Description                                     *
+* --------- --------     --     ---------------------------------               *
+* balls			uint16_t		 I			1 to BALL_POOL																	*
+*																																								*
+* RETURN VALUE: void                                                            *
+*                                                                               *
+********************************************************************************/
+void Game_SetBalls(uint16_t balls)
+{
+	game.served = balls < 1 ? 1 : balls > BALL_POOL ? BALL_POOL : balls;
+}
+
+/********************************************************************************
+*                                                                               *
+* FUNCTION NAME: Game_Step				                                              *
+*                                                                               *
+* PURPOSE: One fixed step of the game: the paddle, then the balls								*
+* ARGUMENT LIST:                                                                *
+*                                                                               *
+* Argument  Type         IO     Description                                     *
+* --------- --------     --     ---------------------------------               *
+* sample		uint16_t		 I			Last ADC sample of the potentiometer						*
+*																																								*
+* RETURN VALUE: the GAME_* events of the step                                   *
+*                                                                               *
+********************************************************************************/
+uint32_t Game_Step(uint16_t sample)
+{
+	events = 0;
+	MovePaddle(sample);
+	MoveBalls();
+	return events;
+}
+
+/********************************************************************************
+*                                                                               *
+* FUNCTION NAME: Game_Save				                                              *
+*                                                                               *
+* PURPOSE: Take a snapshot of the game, to pause it or to play it again				*
+* ARGUMENT LIST:                                                                *
+*                                                                               *
+* Argument  Type         IO     Description                                     *
+* --------- --------     --     ---------------------------------               *
+* copy			GameState*	 O			Snapshot																				*
+*																																								*
+* RETURN VALUE: void                                                            *
+*                                                                               *
+********************************************************************************/
+void Game_Save(GameState *copy)
+{
+	*copy = game;
+}
+
+/********************************************************************************
+*                                                                               *
+* FUNCTION NAME: Game_Restore			                                              *
+*                                                                               *
+* PURPOSE: Go back to a snapshot: the same samples from there give the same		*
+*					 steps																																*
+* ARGUMENT LIST:                                                                *
+*                                                                               *
+* Argument  Type         IO     Description                                     *
+* --------- --------     --     ---------------------------------               *
+* copy			GameState*	 I			Snapshot taken by Game_Save											*
+*																																								*
+* RETURN VALUE: void                                                            *
+*                                                                               *
+********************************************************************************/
+void Game_Restore(const GameState *copy)
+{
+	game = *copy;
+}
+
+/********************************************************************************
+*                                                                               *
+* FUNCTION NAME: Game_Hash				                                              *
+*                                                                               *
+* PURPOSE: FNV-1a hash of a state, to tell whether two runs went the same way.	*
+*					 The state has no padding, its bytes are hashed in order							*
+* ARGUMENT LIST:                                                                *
+*                                                                               *
+* Argument  Type         IO     Description                                     *
+* --------- --------     --     ---------------------------------               *
+* state			GameState*	 I			State to hash																		*
+*																																								*
+* RETURN VALUE: the hash                                                        *
+*                                                                               *
+********************************************************************************/
+uint32_t Game_Hash(const GameState *state)
+{
+	const uint8_t *byte = (const uint8_t *)state;
+	uint32_t hash = 2166136261u;
+	
+	while(byte < (const uint8_t *)state + sizeof(GameState))
+	{
+		hash = (hash ^ *byte++) * 16777619u;
+	}
+	return hash;
+}
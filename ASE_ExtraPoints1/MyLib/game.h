@@ -0,0 +1,58 @@
+#include "../GLCD/GLCD.h"							/* MAX_X, MAX_Y									*/
+#include "ball.h"
+
+#ifndef __GAME_H
+#define __GAME_H
+
+/*
+ * Rules of the game, with no register and no LCD access: the board feeds them
+ * the ADC samples in functs.c, the host simulation in sim/pong_sim.c
+ */
+
+/* Ball edge positions on both axis */
+#define MIN_BALLX 6
+#define MAX_BALLX MAX_X - 6
+
+#define MIN_BALLY 6
+#define MAX_BALLY MAX_Y - 33
+
+/* ADC samples at the ends of the paddle run */
+#define MAX_PADDLE 0xD60 /* 3424 decimal */
+#define MIN_PADDLE 0x281 /* 641 decimal */
+
+/* Balls of a serve until the joystick picks others on the start screen, up to BALL_POOL:
+ * more than one is the multi-ball mode */
+#define GAME_BALLS		1
+
+/* What happened during a step, for the sounds and the screen */
+#define GAME_BOUNCE		0x01		/* a ball bounced on a wall or on a side of the paddle		*/
+#define GAME_HIT			0x02		/* the paddle sent a ball back, the score went up					*/
+#define GAME_RECORD		0x04		/* the record went up with the score											*/
+#define GAME_OVER			0x08		/* the last ball went past the paddle											*/
+#define GAME_MISS			0x10		/* a ball went past the paddle, others are still in play	*/
+
+/*
+ * State of the game, read only outside game.c: a snapshot is a plain copy of it.
+ * 184 bytes, words first, the fields a step reads next to each other
+ */
+typedef struct {
+	BallPool balls;								/* sub-pixel positions and velocities			*/
+	int score, record;
+	uint16_t paddle_x, paddle_y;	/* top-left pixel of the paddle						*/
+	uint16_t paddle_old;					/* paddle_x at the last step, for the spin	*/
+	uint16_t last_sample;					/* last ADC sample the paddle moved for		*/
+	uint16_t served;							/* balls of a serve												*/
+	uint16_t lost;								/* balls gone past the paddle in the game	*/
+} GameState;
+
+extern GameState game;
+
+void Game_Start(void);
+void Game_Serve(void);
+void Game_SetBalls(uint16_t balls);
+uint32_t Game_Step(uint16_t sample);
+void Game_Save(GameState *copy);
+void Game_Restore(const GameState *copy);
+uint32_t Game_Hash(const GameState *state);
+
+#endif
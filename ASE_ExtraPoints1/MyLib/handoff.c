@@ -0,0 +1,77 @@
+#include "handoff.h"
+
+/* The published copy is input_buf[input_seq & 1], the interrupts fill the other one */
+static volatile GameInput input_buf[2];
+static volatile uint32_t input_seq = 0;
+
+/********************************************************************************
+*                                                                               *
+* FUNCTION NAME: Input_Begin																										*
+*                                                                               *
+* PURPOSE: Start a new copy of the input from the published one. Interrupts		*
+*					 only, and Input_Publish must follow in the same handler							*
+* ARGUMENT LIST:																																*
+*                                                                               *
+* Argument  Type         IO     Description																			*
+* --------- --------     --     ---------------------------------								*
+*                                                                               *
+* RETURN VALUE: the copy to change																							*
+*                                                                               *
+********************************************************************************/
+volatile GameInput *Input_Begin()
+{
+	volatile GameInput *front = &input_buf[input_seq & 1];
+	volatile GameInput *back = &input_buf[(input_seq + 1) & 1];
+	
+	back->sample = front->sample;
+	back->held = front->held;
+	return back;
+}
+
+/********************************************************************************
+*                                                                               *
+* FUNCTION NAME: Input_Publish																									*
+*                                                                               *
+* PURPOSE: Make the copy filled since Input_Begin the one the loop reads				*
+* ARGUMENT LIST:																																*
+*                                                                               *
+* Argument  Type         IO     Description																			*
+* --------- --------     --     ---------------------------------								*
+*                                                                               *
+* RETURN VALUE: void																														*
+*                                                                               *
+********************************************************************************/
+void Input_Publish()
+{
+	input_seq++;
+}
+
+/********************************************************************************
+*                                                                               *
+* FUNCTION NAME: Input_Read																											*
+*                                                                               *
+* PURPOSE: Copy the published input, loop in main only. A single publish				*
+*					 during the copy fills the other buffer and leaves it whole; after		*
+*					 two the copy may be torn, and it is taken again											*
+* ARGUMENT LIST:																																*
+*                                                                               *
+* Argument  Type         IO     Description																			*
+* --------- --------     --     ---------------------------------								*
+* in				GameInput*	 O			Consistent copy of the input										*
+*																																								*
+* RETURN VALUE: void																														*
+*                                                                               *
+********************************************************************************/
+void Input_Read(GameInput *in)
+{
+	uint32_t seq;
+	volatile GameInput *front;
+	
+	do
+	{
+		seq = input_seq;
+		front = &input_buf[seq & 1];
+		in->sample = front->sample;
+		in->held = front->held;
+	} while(input_seq - seq > 1);
+}
@@ -0,0 +1,336 @@
+#include "scene.h"
+#include "../GLCD/GLCD_band.h"
+
+/* Rectangle with exclusive right and bottom edges */
+typedef struct {
+	int16_t x0, y0, x1, y1;
+} DirtyRect;
+
+static SceneObject *objects[SCENE_MAX_OBJECTS];
+static uint8_t object_count;
+
+static DirtyRect dirty[SCENE_MAX_DIRTY];
+static uint8_t dirty_count;
+
+static uint16_t background;
+static uint32_t pixel_budget;
+static SceneStats stats;
+
+/* Rectangle helpers */
+static int Overlaps(const DirtyRect *a, const DirtyRect *b)
+{
+	/* Touching rectangles are merged too, their union is still a rectangle */
+	return a->x0 <= b->x1 && b->x0 <= a->x1 && a->y0 <= b->y1 && b->y0 <= a->y1;
+}
+
+static int Intersects(const DirtyRect *a, const DirtyRect *b)
+{
+	return a->x0 < b->x1 && b->x0 < a->x1 && a->y0 < b->y1 && b->y0 < a->y1;
+}
+
+static void Union(DirtyRect *a, const DirtyRect *b)
+{
+	a->x0 = a->x0 < b->x0 ? a->x0 : b->x0;
+	a->y0 = a->y0 < b->y0 ? a->y0 : b->y0;
+	a->x1 = a->x1 > b->x1 ? a->x1 : b->x1;
+	a->y1 = a->y1 > b->y1 ? a->y1 : b->y1;
+}
+
+static uint32_t Area(const DirtyRect *r)
+{
+	return (uint32_t)(r->x1 - r->x0) * (uint32_t)(r->y1 - r->y0);
+}
+
+static void ObjectRect(const SceneObject *obj, DirtyRect *r)
+{
+	r->x0 = obj->x;
+	r->y0 = obj->y;
+	r->x1 = obj->x + obj->w;
+	r->y1 = obj->y + obj->h;
+}
+
+/********************************************************************************
+*                                                                               *
+* FUNCTION NAME: Scene_Init				                                              *
+*                                                                               *
+* PURPOSE: Empty the scene and set its background												*
+* ARGUMENT LIST:                                                                *
+*                                                                               *
+* Argument  Type         IO     Description                                     *
+* --------- --------     --     ---------------------------------               *
+* bkColor		uint16_t		 I			Color of the background													*
+*	budget		uint32_t		 I			Pixels that a frame may write, 0 for no limit		*
+*																																								*
+* RETURN VALUE: void                                                            *
+*                                                                               *
+********************************************************************************/
+void Scene_Init(uint16_t bkColor, uint32_t budget)
+{
+	object_count = 0;
+	dirty_count = 0;
+	background = bkColor;
+	pixel_budget = budget;
+	stats.frames = 0;
+	stats.rects = 0;
+	stats.pixels = 0;
+	stats.max_pixels = 0;
+	stats.total_pixels = 0;
+	stats.deferred = 0;
+}
+
+/********************************************************************************
+*                                                                               *
+* FUNCTION NAME: Scene_Add				                                              *
+*                                                                               *
+* PURPOSE: Add an object on top of the ones already in the scene								*
+* ARGUMENT LIST:                                                                *
+*                                                                               *
+* Argument  Type         IO     Description                                     *
+* --------- --------     --     ---------------------------------               *
+* obj				SceneObject* I			Object, owned by the caller											*
+*																																								*
+* RETURN VALUE: int, 0 if added, -1 if the scene is full                        *
+*                                                                               *
+********************************************************************************/
+int Scene_Add(SceneObject *obj)
+{
+	if(object_count == SCENE_MAX_OBJECTS)
+	{
+		return -1;
+	}
+	objects[object_count++] = obj;
+	return 0;
+}
+
+/********************************************************************************
+*                                                                               *
+* FUNCTION NAME: Scene_Move				                                              *
+*                                                                               *
+* PURPOSE: Move an object, marking both its old and new area as dirty						*
+* ARGUMENT LIST:                                                                *
+*                                                                               *
+* Argument  Type         IO     Description                                     *
+* --------- --------     --     ---------------------------------               *
+* obj				SceneObject* I			Object to move																	*
+*	x, y			uint16_t		 I			New top-left corner															*
+*																																								*
+* RETURN VALUE: void                                                            *
+*                                                                               *
+********************************************************************************/
+void Scene_Move(SceneObject *obj, uint16_t x, uint16_t y)
+{
+	if(obj->x == x && obj->y == y)
+	{
+		return;
+	}
+	Scene_Invalidate(obj->x, obj->y, obj->w, obj->h);
+	obj->x = x;
+	obj->y = y;
+	Scene_Invalidate(obj->x, obj->y, obj->w, obj->h);
+}
+
+/********************************************************************************
+*                                                                               *
+* FUNCTION NAME: Scene_Invalidate	                                              *
+*                                                                               *
+* PURPOSE: Mark an area to be repainted by the next Scene_Render.								*
+*					 Overlapping areas are merged, so that every pixel is written once,		*
+*					 and an area touching a custom painted object grows to include it		*
+* ARGUMENT LIST:                                                                *
+*                                                                               *
+* Argument  Type         IO     Description                                     *
+* --------- --------     --     ---------------------------------               *
+*	x, y			uint16_t		 I			Top-left corner																	*
+*	w, h			uint16_t		 I			Size in pixels																	*
+*																																								*
+* RETURN VALUE: void                                                            *
+*                                                                               *
+********************************************************************************/
+void Scene_Invalidate(uint16_t x, uint16_t y, uint16_t w, uint16_t h)
+{
+	DirtyRect r, o;
+	uint32_t growth, best_growth;
+	size_t i, best;
+	int merged;
+
+	/* Clip to the screen, coordinates that wrapped below zero are dropped */
+	if(x >= MAX_X || y >= MAX_Y || w == 0 || h == 0)
+	{
+		return;
+	}
+	r.x0 = x;
+	r.y0 = y;
+	r.x1 = (x + w > MAX_X) ? MAX_X : x + w;
+	r.y1 = (y + h > MAX_Y) ? MAX_Y : y + h;
+
+	do
+	{
+		merged = 0;
+		for(i = 0; i < object_count; i++)
+		{
+			ObjectRect(objects[i], &o);
+			if(objects[i]->paint != NULL && Intersects(&r, &o))
+			{
+				o.x1 = o.x1 > MAX_X ? MAX_X : o.x1;
+				o.y1 = o.y1 > MAX_Y ? MAX_Y : o.y1;
+				if(o.x0 < r.x0 || o.y0 < r.y0 || o.x1 > r.x1 || o.y1 > r.y1)
+				{
+					Union(&r, &o);
+					merged = 1;
+				}
+			}
+		}
+		for(i = 0; i < dirty_count; i++)
+		{
+			if(Overlaps(&r, &dirty[i]))
+			{
+				Union(&r, &dirty[i]);
+				dirty[i] = dirty[--dirty_count];
+				merged = 1;
+				break;
+			}
+		}
+	} while(merged);
+
+	if(dirty_count == SCENE_MAX_DIRTY)
+	{
+		/* No room left: merge with the rectangle that grows the least */
+		best = 0;
+		best_growth = 0xFFFFFFFF;
+		for(i = 0; i < dirty_count; i++)
+		{
+			o = dirty[i];
+			Union(&o, &r);
+			growth = Area(&o) - Area(&dirty[i]);
+			if(growth < best_growth)
+			{
+				best_growth = growth;
+				best = i;
+			}
+		}
+		Union(&dirty[best], &r);
+		return;
+	}
+	dirty[dirty_count++] = r;
+}
+
+/********************************************************************************
+*                                                                               *
+* FUNCTION NAME: PaintBand				                                              *
+*                                                                               *
+* PURPOSE: Compose a dirty band: the background, then every filled object			*
+*					 clipped by the band renderer, in the order they were added.					*
+*					 Custom painted objects are drawn after the band is written						*
+* ARGUMENT LIST:                                                                *
+*                                                                               *
+* Argument  Type         IO     Description                                     *
+* --------- --------     --     ---------------------------------               *
+*	x, y			uint16_t		 I			Top-left corner of the band area								*
+*	w, h			uint16_t		 I			Size of the band area														*
+*																																								*
+* RETURN VALUE: void                                                            *
+*                                                                               *
+********************************************************************************/
+static void PaintBand(uint16_t x, uint16_t y, uint16_t w, uint16_t h)
+{
+	size_t i;
+
+	Band_FillRect(x, y, w, h, background);
+	for(i = 0; i < object_count; i++)
+	{
+		if(objects[i]->paint == NULL)
+		{
+			Band_FillRect(objects[i]->x, objects[i]->y, objects[i]->w, objects[i]->h, objects[i]->color);
+		}
+	}
+}
+
+/********************************************************************************
+*                                                                               *
+* FUNCTION NAME: Scene_Render			                                              *
+*                                                                               *
+* PURPOSE: Repaint the dirty rectangles through the band renderer. When the		*
+*					 pixel budget would be exceeded, the remaining rectangles are left		*
+*					 for the next frame, but at least one rectangle is always painted			*
+* ARGUMENT LIST:                                                                *
+*                                                                               *
+* Argument  Type         IO     Description                                     *
+* --------- --------     --     ---------------------------------               *
+*                                                                               *
+* RETURN VALUE: void                                                            *
+*                                                                               *
+********************************************************************************/
+void Scene_Render(void)
+{
+	DirtyRect painted[SCENE_MAX_DIRTY], o;
+	uint32_t pixels = 0, rects = 0;
+	size_t i, j;
+
+	while(dirty_count > 0)
+	{
+		if(pixel_budget != 0 && pixels != 0 && pixels + Area(&dirty[dirty_count - 1]) > pixel_budget)
+		{
+			stats.deferred++;
+			break;
+		}
+		dirty_count--;
+		painted[rects] = dirty[dirty_count];
+		Band_Invalidate(painted[rects].x0, painted[rects].y0,
+			painted[rects].x1 - painted[rects].x0, painted[rects].y1 - painted[rects].y0);
+		pixels += Area(&painted[rects]);
+		rects++;
+	}
+	if(rects == 0)
+	{
+		return;
+	}
+
+	pixels = Band_Render(PaintBand);
+
+	/* Dirty rectangles always contain the custom painted objects they touch */
+	for(i = 0; i < object_count; i++)
+	{
+		if(objects[i]->paint == NULL)
+		{
+			continue;
+		}
+		ObjectRect(objects[i], &o);
+		for(j = 0; j < rects; j++)
+		{
+			if(Intersects(&o, &painted[j]))
+			{
+				objects[i]->paint(objects[i]);
+				pixels += Area(&o);
+				break;
+			}
+		}
+	}
+
+	stats.frames++;
+	stats.rects = rects;
+	stats.pixels = pixels;
+	stats.total_pixels += pixels;
+	if(pixels > stats.max_pixels)
+	{
+		stats.max_pixels = pixels;
+	}
+}
+
+/********************************************************************************
+*                                                                               *
+* FUNCTION NAME: Scene_GetStats		                                              *
+*                                                                               *
+* PURPOSE: Copy the redraw statistics																						*
+* ARGUMENT LIST:                                                                *
+*                                                                               *
+* Argument  Type         IO     Description                                     *
+* --------- --------     --     ---------------------------------               *
+* out				SceneStats*	 O			Destination																			*
+*																																								*
+* RETURN VALUE: void                                                            *
+*                                                                               *
+********************************************************************************/
+void Scene_GetStats(SceneStats *out)
+{
+	*out = stats;
+}
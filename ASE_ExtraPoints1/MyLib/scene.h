@@ -0,0 +1,37 @@
+#include "LPC17xx.H"                    /* LPC17xx definitions                */
+#include "../GLCD/GLCD.h"
+
+#ifndef __SCENE_H
+#define __SCENE_H
+
+/* Maximum number of objects and of pending dirty rectangles */
+#define SCENE_MAX_OBJECTS	16
+#define SCENE_MAX_DIRTY		8
+
+/* An object of the scene, painted in the order it was added */
+typedef struct SceneObject {
+	uint16_t x, y;													/* top-left corner									*/
+	uint16_t w, h;													/* size in pixels										*/
+	uint16_t color;													/* fill color												*/
+	void (*paint)(const struct SceneObject *obj);	/* custom painter, NULL for a fill	*/
+	void *data;															/* data of a custom painter					*/
+} SceneObject;
+
+/* Redraw statistics */
+typedef struct {
+	uint32_t frames;					/* calls to Scene_Render that painted something		*/
+	uint32_t rects;						/* rectangles painted in the last frame						*/
+	uint32_t pixels;					/* pixels written in the last frame								*/
+	uint32_t max_pixels;			/* pixels written in the worst frame							*/
+	uint32_t total_pixels;		/* pixels written since Scene_Init								*/
+	uint32_t deferred;				/* frames that left work for the next one					*/
+} SceneStats;
+
+void Scene_Init(uint16_t bkColor, uint32_t budget);
+int  Scene_Add(SceneObject *obj);
+void Scene_Move(SceneObject *obj, uint16_t x, uint16_t y);
+void Scene_Invalidate(uint16_t x, uint16_t y, uint16_t w, uint16_t h);
+void Scene_Render(void);
+void Scene_GetStats(SceneStats *stats);
+
+#endif
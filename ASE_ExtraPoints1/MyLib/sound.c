@@ -0,0 +1,254 @@
+#include "sound.h"
+
+/* A period of the sine, 10 bits around 410 as the DAC had it from TIMER0 */
+static const uint16_t sine[SOUND_SAMPLES] = {
+	410,	490,	567,	637,	699,	750,	788,	811,
+	819,	811,	788,	750,	699,	637,	567,	490,
+	410,	330,	253,	183,	121,	70,		32,		9,
+	1,		9,		32,		70,		121,	183,	253,	330
+};
+
+/* The notes of the effects */
+static const Note wall_notes[] = { { 440, 30 } };
+static const Note paddle_notes[] = { { 523, 40 } };
+static const Note score_notes[] = { { 523, 60 }, { 659, 60 }, { 784, 100 } };
+static const Note lose_notes[] = { { 392, 150 }, { 0, 40 }, { 330, 150 }, { 0, 40 }, { 262, 400 } };
+
+static const Note *const effect_notes[SOUND_EFFECTS] = { 0, wall_notes, paddle_notes, score_notes, lose_notes };
+static const uint16_t effect_len[SOUND_EFFECTS] = { 0, 1, 1, 3, 5 };
+
+/********************************************************************************
+*                                                                               *
+* FUNCTION NAME: Sound_Wave				                                              *
+*                                                                               *
+* PURPOSE: Fill a block with SOUND_PERIODS periods of the sine, as words for		*
+*					 DACR: the value in bits 15:6																					*
+* ARGUMENT LIST:                                                                *
+*                                                                               *
+* Argument  Type         IO     Description                                     *
+* --------- --------     --     ---------------------------------               *
+* block			uint32_t*		 O			SOUND_BLOCK words																*
+*																																								*
+* RETURN VALUE: void                                                            *
+*                                                                               *
+********************************************************************************/
+void Sound_Wave(uint32_t *block)
+{
+	int i;
+
+	for(i = 0; i < SOUND_BLOCK; i++)
+	{
+		block[i] = (uint32_t)sine[i % SOUND_SAMPLES] << 6;
+	}
+}
+
+/********************************************************************************
+*                                                                               *
+* FUNCTION NAME: Sound_Silence		                                              *
+*                                                                               *
+* PURPOSE: The DACR word of a rest, the middle of the sine											*
+* ARGUMENT LIST:                                                                *
+*                                                                               *
+* Argument  Type         IO     Description                                     *
+* --------- --------     --     ---------------------------------               *
+*                                                                               *
+* RETURN VALUE: uint32_t, the word                                              *
+*                                                                               *
+********************************************************************************/
+uint32_t Sound_Silence()
+{
+	return (uint32_t)sine[0] << 6;
+}
+
+/********************************************************************************
+*                                                                               *
+* FUNCTION NAME: Sound_Blocks			                                              *
+*                                                                               *
+* PURPOSE: Blocks a note lasts, the nearest to its time and at least one				*
+* ARGUMENT LIST:                                                                *
+*                                                                               *
+* Argument  Type         IO     Description                                     *
+* --------- --------     --     ---------------------------------               *
+* note			Note*				 I			The note																				*
+*																																								*
+* RETURN VALUE: uint32_t, the blocks                                            *
+*                                                                               *
+********************************************************************************/
+uint32_t Sound_Blocks(const Note *note)
+{
+	uint32_t freq = note->freq != 0 ? note->freq : SOUND_REST_FREQ;
+	uint32_t blocks = (freq * note->ms + 500 * SOUND_PERIODS) / (1000 * SOUND_PERIODS);
+
+	return blocks != 0 ? blocks : 1;
+}
+
+/********************************************************************************
+*                                                                               *
+* FUNCTION NAME: Sound_Start			                                              *
+*                                                                               *
+* PURPOSE: Put the sequence at the first note of an effect. SOUND_NONE and an		*
+*					 unknown effect leave it over																					*
+* ARGUMENT LIST:                                                                *
+*                                                                               *
+* Argument  Type         IO     Description                                     *
+* --------- --------     --     ---------------------------------               *
+* seq				SoundSeq*		 O			The sequence																		*
+* effect		uint16_t		 I			SOUND_*																					*
+*																																								*
+* RETURN VALUE: void                                                            *
+*                                                                               *
+********************************************************************************/
+void Sound_Start(SoundSeq *seq, uint16_t effect)
+{
+	seq->note = 0;
+	seq->notes = 0;
+	seq->blocks = 0;
+	if(effect < SOUND_EFFECTS && effect_len[effect] != 0)
+	{
+		seq->note = effect_notes[effect];
+		seq->notes = effect_len[effect] - 1;
+		seq->blocks = Sound_Blocks(seq->note);
+	}
+}
+
+/********************************************************************************
+*                                                                               *
+* FUNCTION NAME: Sound_NextBlock	                                              *
+*                                                                               *
+* PURPOSE: The next block of the sequence, called at the end of each block			*
+* ARGUMENT LIST:                                                                *
+*                                                                               *
+* Argument  Type         IO     Description                                     *
+* --------- --------     --     ---------------------------------               *
+* seq				SoundSeq*		 IO			The sequence																		*
+*																																								*
+* RETURN VALUE: uint32_t, DACCNTVAL of the block with SOUND_REST for a rest, 0  *
+*               when the effect is over                                         *
+*                                                                               *
+********************************************************************************/
+uint32_t Sound_NextBlock(SoundSeq *seq)
+{
+	uint32_t freq;
+
+	if(seq->blocks == 0)
+	{
+		if(seq->notes == 0)
+		{
+			seq->note = 0;
+			return 0;
+		}
+		seq->note++;
+		seq->notes--;
+		seq->blocks = Sound_Blocks(seq->note);
+	}
+	seq->blocks--;
+	if(seq->note->freq == 0)
+	{
+		return SOUND_REST | (SOUND_CLOCK / (SOUND_REST_FREQ * SOUND_SAMPLES));
+	}
+	freq = seq->note->freq;
+	return SOUND_CLOCK / (freq * SOUND_SAMPLES);
+}
+
+/********************************************************************************
+*                                                                               *
+* FUNCTION NAME: Sound_Reset			                                              *
+*                                                                               *
+* PURPOSE: Nothing playing and nothing waiting																	*
+* ARGUMENT LIST:                                                                *
+*                                                                               *
+* Argument  Type         IO     Description                                     *
+* --------- --------     --     ---------------------------------               *
+* player		SoundPlayer* O			The player																			*
+*																																								*
+* RETURN VALUE: void                                                            *
+*                                                                               *
+********************************************************************************/
+void Sound_Reset(SoundPlayer *player)
+{
+	Sound_Start(&player->seq, SOUND_NONE);
+	player->playing = SOUND_NONE;
+	player->queued = 0;
+	player->coalesced = 0;
+}
+
+/********************************************************************************
+*                                                                               *
+* FUNCTION NAME: Sound_Enqueue		                                              *
+*                                                                               *
+* PURPOSE: Queue an effect after the one playing. The same effect waiting, and	*
+*					 the less important ones, are merged into it: a burst of hits leaves	*
+*					 one sound of each kind at most, the most important first							*
+* ARGUMENT LIST:                                                                *
+*                                                                               *
+* Argument  Type         IO     Description                                     *
+* --------- --------     --     ---------------------------------               *
+* player		SoundPlayer* IO			The player																			*
+* effect		uint16_t		 I			SOUND_*																					*
+*																																								*
+* RETURN VALUE: int, 1 if the player is quiet: Sound_Next starts the effect     *
+*                                                                               *
+********************************************************************************/
+int Sound_Enqueue(SoundPlayer *player, uint16_t effect)
+{
+	uint16_t i, kept = 0;
+
+	if(effect == SOUND_NONE || effect >= SOUND_EFFECTS)
+	{
+		return 0;
+	}
+	for(i = 0; i < player->queued; i++)
+	{
+		if(player->queue[i] == effect)
+		{
+			player->coalesced++;
+			return 0;
+		}
+		if(player->queue[i] > effect)
+		{
+			player->queue[kept++] = player->queue[i];
+		}
+	}
+	player->coalesced += player->queued - kept;
+	player->queue[kept] = effect;
+	player->queued = kept + 1;
+	return player->playing == SOUND_NONE;
+}
+
+/********************************************************************************
+*                                                                               *
+* FUNCTION NAME: Sound_Next				                                              *
+*                                                                               *
+* PURPOSE: The next block to play: of the effect playing, or of the first one		*
+*					 waiting when it is over																							*
+* ARGUMENT LIST:                                                                *
+*                                                                               *
+* Argument  Type         IO     Description                                     *
+* --------- --------     --     ---------------------------------               *
+* player		SoundPlayer* IO			The player																			*
+*																																								*
+* RETURN VALUE: uint32_t, as Sound_NextBlock, 0 when the player is quiet        *
+*                                                                               *
+********************************************************************************/
+uint32_t Sound_Next(SoundPlayer *player)
+{
+	uint32_t next = Sound_NextBlock(&player->seq);
+	uint16_t i;
+
+	while(next == 0 && player->queued != 0)
+	{
+		player->playing = player->queue[0];
+		for(i = 1; i < player->queued; i++)
+		{
+			player->queue[i - 1] = player->queue[i];
+		}
+		player->queued--;
+		Sound_Start(&player->seq, player->playing);
+		next = Sound_NextBlock(&player->seq);
+	}
+	if(next == 0)
+	{
+		player->playing = SOUND_NONE;
+	}
+	return next;
+}
@@ -0,0 +1,22 @@
+#include "LPC17xx.H"                    /* LPC17xx definitions                */
+#include "../GLCD/GLCD.h"
+#include "scene.h"
+
+#ifndef __SPRITE_H
+#define __SPRITE_H
+
+/* A moving rectangle, solid or with a bitmap */
+typedef struct {
+	SceneObject obj;				/* position, size and color, first so that the scene can hold it	*/
+	const uint16_t *bitmap;	/* obj.w * obj.h RGB565 pixels row by row, NULL for a solid color	*/
+	void (*uncover)(uint16_t x, uint16_t y, uint16_t w, uint16_t h);	/* repaints what the sprite leaves, NULL to fill it with bkColor	*/
+	uint16_t bkColor;
+} Sprite;
+
+void Sprite_Init(Sprite *sprite, uint16_t x, uint16_t y, uint16_t w, uint16_t h, uint16_t color, const uint16_t *bitmap);
+void Sprite_Draw(const Sprite *sprite);
+void Sprite_MoveTo(Sprite *sprite, uint16_t x, uint16_t y);
+void Sprite_Show(Sprite *sprite, uint16_t x, uint16_t y, uint16_t w, uint16_t h);
+void Sprite_Hide(Sprite *sprite);
+
+#endif
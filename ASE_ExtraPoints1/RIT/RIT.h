@@ -17,6 +17,7 @@ extern void disable_RIT( void );
 extern void reset_RIT( void );
 /* IRQ_RIT.c */
 extern void RIT_IRQHandler (void);
+extern void PostInput (uint16_t input, uint16_t what, uint32_t time);
 
 #endif /* end __RIT_H */
 /*****************************************************************************
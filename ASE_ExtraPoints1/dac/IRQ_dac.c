@@ -0,0 +1,56 @@
+/*********************************************************************************************************
+**--------------File Info---------------------------------------------------------------------------------
+** File name:           IRQ_dac.c
+** Last modified Date:  2026-10-17
+** Last Version:        V1.00
+** Descriptions:        functions to manage the GPDMA interrupt of the DAC and the ADC
+** Correlated files:    dac.h
+**--------------------------------------------------------------------------------------------------------
+*********************************************************************************************************/
+#include "lpc17xx.h"
+#include "dac.h"
+#include "../adc/adc.h"
+
+/******************************************************************************
+** Function name:		DMA_IRQHandler
+**
+** Descriptions:		GPDMA interrupt handler: channel 0 played a block of the
+**									sound, the next one is started. Once per SOUND_PERIODS
+**									periods of the tone. Channel 1 filled a block of the ring
+**									of the ADC, every ADC_BLOCK samples. A channel stopped by
+**									an error is started again by its owner
+**
+** parameters:			None
+** Returned value:		None
+**
+******************************************************************************/
+void DMA_IRQHandler (void)
+{
+	if(LPC_GPDMA->DMACIntErrStat & 1)
+	{
+		LPC_GPDMA->DMACIntErrClr = 1;
+		LPC_GPDMA->DMACIntTCClear = 1;
+		Sound_Error();
+	}
+	else if(LPC_GPDMA->DMACIntTCStat & 1)
+	{
+		LPC_GPDMA->DMACIntTCClear = 1;	/* clear interrupt flag */
+		Sound_Block();
+	}
+	if(LPC_GPDMA->DMACIntErrStat & 2)
+	{
+		LPC_GPDMA->DMACIntErrClr = 2;
+		LPC_GPDMA->DMACIntTCClear = 2;
+		ADC_Error();
+	}
+	else if(LPC_GPDMA->DMACIntTCStat & 2)
+	{
+		LPC_GPDMA->DMACIntTCClear = 2;
+		ADC_Block();
+	}
+  return;
+}
+
+/******************************************************************************
+**                            End Of File
+******************************************************************************/
@@ -0,0 +1,26 @@
+/*********************************************************************************************************
+**--------------File Info---------------------------------------------------------------------------------
+** File name:           dac.h
+** Last modified Date:  2026-10-17
+** Last Version:        V1.00
+** Descriptions:        Prototypes of functions included in the lib_dac, IRQ_dac .c files
+** Correlated files:    lib_dac.c, IRQ_dac.c
+**--------------------------------------------------------------------------------------------------------
+*********************************************************************************************************/
+#ifndef __DAC_H
+#define __DAC_H
+
+#include <stdint.h>
+
+/* lib_dac.c */
+extern void DAC_init( void );
+extern void Sound_Play( uint16_t effect );
+extern void Sound_Block( void );
+extern void Sound_Error( void );
+/* IRQ_dac.c */
+extern void DMA_IRQHandler (void);
+
+#endif /* end __DAC_H */
+/*****************************************************************************
+**                            End Of File
+******************************************************************************/
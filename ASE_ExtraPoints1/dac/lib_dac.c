@@ -0,0 +1,155 @@
+/*********************************************************************************************************
+**--------------File Info---------------------------------------------------------------------------------
+** File name:           lib_dac.c
+** Last modified Date:  2026-10-17
+** Last Version:        V1.00
+** Descriptions:        atomic functions to be used by higher sw levels
+** Correlated files:    lib_dac.c, IRQ_dac.c, MyLib/sound.c
+**--------------------------------------------------------------------------------------------------------
+*********************************************************************************************************/
+#include "lpc17xx.h"
+#include "dac.h"
+#include "../MyLib/sound.h"
+
+/* GPDMA request line of the DAC */
+#define DMA_DAC			7
+
+/* The block of the sine and the word of a rest, read by the GPDMA */
+static uint32_t block[SOUND_BLOCK];
+static uint32_t silence;
+
+/* The effect playing and the ones waiting, moved on by the GPDMA interrupt */
+static SoundPlayer player;
+
+/******************************************************************************
+** Function name:		StartBlock
+**
+** Descriptions:		Set the pitch and play one block on GPDMA channel 0, from
+**									memory to DACR at each timeout of the DAC counter. A rest
+**									sends the silence word without incrementing
+**
+** parameters:			next: what Sound_Next returned, not 0
+** Returned value:		None
+**
+******************************************************************************/
+static void StartBlock( uint32_t next )
+{
+	LPC_DAC->DACCNTVAL = next & 0xFFFF;
+	LPC_GPDMACH0->DMACCSrcAddr = (next & SOUND_REST) ? (uint32_t)&silence : (uint32_t)block;
+	LPC_GPDMACH0->DMACCDestAddr = (uint32_t)&LPC_DAC->DACR;
+	LPC_GPDMACH0->DMACCLLI = 0;
+	LPC_GPDMACH0->DMACCControl = SOUND_BLOCK |			/* transfers											*/
+															 (2 << 18) | (2 << 21) |	/* 32 bit words				*/
+															 ((next & SOUND_REST) ? 0 : (1 << 26)) |	/* source increment	*/
+															 (1UL << 31);				/* interrupt at the end						*/
+	LPC_GPDMACH0->DMACCConfig = (1 << 0) |					/* enable													*/
+															(DMA_DAC << 6) |		/* to the DAC											*/
+															(1 << 11) |					/* memory to peripheral						*/
+															(1 << 14) |					/* error interrupt								*/
+															(1 << 15);					/* terminal count interrupt				*/
+}
+
+/******************************************************************************
+** Function name:		DAC_init
+**
+** Descriptions:		P0.26 as AOUT, the sine in memory and the GPDMA on. The
+**									DAC counter only runs while an effect plays
+**
+** parameters:			None
+** Returned value:		None
+**
+******************************************************************************/
+void DAC_init( void )
+{
+	LPC_PINCON->PINSEL1 |= (1<<21);			/* P0.26 is AOUT											*/
+	LPC_PINCON->PINSEL1 &= ~(1<<20);
+	LPC_GPIO0->FIODIR |= (1<<26);
+
+	Sound_Wave(block);
+	silence = Sound_Silence();
+	Sound_Reset(&player);
+	LPC_DAC->DACR = silence;
+	LPC_DAC->DACCTRL = 0;
+
+	LPC_SC->PCONP |= (1 << 29);					/* Enable power for the GPDMA					*/
+	LPC_GPDMA->DMACIntTCClear = 1;			/* channel 0, the ADC has channel 1		*/
+	LPC_GPDMA->DMACIntErrClr = 1;
+	LPC_GPDMA->DMACConfig = 1;					/* GPDMA enabled, little endian				*/
+
+	/* A block lasts 8 periods of the tone: the lowest priority is early enough */
+	NVIC_SetPriority(DMA_IRQn, 3);
+	NVIC_EnableIRQ(DMA_IRQn);
+}
+
+/******************************************************************************
+** Function name:		Sound_Play
+**
+** Descriptions:		Queue an effect, it plays after the one playing. It only
+**									starts the DAC when it is quiet, the GPDMA interrupt
+**									goes through the queue
+**
+** parameters:			effect: SOUND_*, SOUND_NONE does nothing
+** Returned value:		None
+**
+******************************************************************************/
+void Sound_Play( uint16_t effect )
+{
+	uint32_t next;
+
+	NVIC_DisableIRQ(DMA_IRQn);
+	if(Sound_Enqueue(&player, effect))
+	{
+		next = Sound_Next(&player);
+		StartBlock(next);
+		LPC_DAC->DACCTRL = (1 << 1) |				/* DACR loads at the timeout				*/
+											 (1 << 2) |				/* counter on												*/
+											 (1 << 3);				/* DMA requests											*/
+	}
+	NVIC_EnableIRQ(DMA_IRQn);
+}
+
+/******************************************************************************
+** Function name:		Sound_Block
+**
+** Descriptions:		A block is over: the next one of the effect or of the
+**									queue, or the DAC back to the silence and its counter off
+**
+** parameters:			None
+** Returned value:		None
+**
+******************************************************************************/
+void Sound_Block( void )
+{
+	uint32_t next = Sound_Next(&player);
+
+	if(next != 0)
+	{
+		StartBlock(next);
+		return;
+	}
+	LPC_DAC->DACCTRL = 0;
+	LPC_DAC->DACR = silence;
+}
+
+/******************************************************************************
+** Function name:		Sound_Error
+**
+** Descriptions:		Channel 0 stopped on an error: the DAC back to the silence
+**									with its counter off and the queue emptied, so that the
+**									next Sound_Play starts the DAC again
+**
+** parameters:			None
+** Returned value:		None
+**
+******************************************************************************/
+void Sound_Error( void )
+{
+	LPC_GPDMACH0->DMACCConfig = 0;
+	LPC_DAC->DACCTRL = 0;
+	LPC_DAC->DACR = silence;
+	Sound_Reset(&player);
+}
+
+/******************************************************************************
+**                            End Of File
+******************************************************************************/
@@ -0,0 +1,148 @@
+/*********************************************************************************************************
+**--------------File Info---------------------------------------------------------------------------------
+** File name:           glcd_bench.c
+** Last modified Date:  2026-10-17
+** Last Version:        V1.00
+** Descriptions:        host bench of the GLCD primitives on the ILI9325 model: draws one frame of the
+**                      game, prints the bus cycles of each primitive and dumps the GRAM as a PPM
+** Correlated files:    GLCD.c, GLCD_emu.c, AsciiLib.c
+**--------------------------------------------------------------------------------------------------------
+*********************************************************************************************************/
+#include <stdio.h>
+#include "../GLCD/GLCD.h"
+#include "../GLCD/GLCD_emu.h"
+
+#ifndef GLCD_EMULATOR
+#error "build with -DGLCD_EMULATOR"
+#endif
+
+/* Where the frame puts things, as the game does */
+#define PADDLE_Y			(MAX_Y - 42)
+#define PADDLE_W			40
+#define PADDLE_H			10
+#define BALL_SIZE			5
+#define WALL					5
+
+static uint32_t fails;
+
+/******************************************************************************
+** Function name:		Expect
+**
+** Descriptions:		Check a pixel of the frame in the GRAM
+**
+** parameters:			x, y: pixel
+**									color: the one it should have
+**									what: printed on a failure
+** Returned value:		None
+**
+******************************************************************************/
+static void Expect(uint16_t x, uint16_t y, uint16_t color, const char *what)
+{
+	uint16_t got = LCDEmu_GetPixel(x, y);
+
+	if(got != color)
+	{
+		printf("FAIL: %s at (%u, %u) is %04X, not %04X\n", what, (unsigned)x, (unsigned)y, got, color);
+		fails++;
+	}
+}
+
+/******************************************************************************
+** Function name:		Rect, Line, Text
+**
+** Descriptions:		The primitives of GLCD.c, each call counted on its own
+**
+** parameters:			as LCD_FillRect, LCD_DrawLine and GUI_TextRotated
+** Returned value:		None
+**
+******************************************************************************/
+static void Rect(uint16_t x, uint16_t y, uint16_t w, uint16_t h, uint16_t color)
+{
+	LCDEmu_Begin("LCD_FillRect");
+	LCD_FillRect(x, y, w, h, color);
+	LCDEmu_End();
+}
+
+static void Line(uint16_t x0, uint16_t y0, uint16_t x1, uint16_t y1, uint16_t color)
+{
+	LCDEmu_Begin("LCD_DrawLine");
+	LCD_DrawLine(x0, y0, x1, y1, color);
+	LCDEmu_End();
+}
+
+static void Text(uint16_t x, uint16_t y, const char *str, uint16_t color, uint16_t angle)
+{
+	LCDEmu_Begin(angle ? "GUI_TextRotated" : "GUI_Text");
+	if(angle)
+		GUI_TextRotated(x, y, (uint8_t *)str, color, Black, angle);
+	else
+		GUI_Text(x, y, (uint8_t *)str, color, Black);
+	LCDEmu_End();
+}
+
+int main(int argc, char **argv)
+{
+	const char *path = argc > 1 ? argv[1] : "frame.ppm";
+	int i;
+
+	LCD_Initialization();
+	LCDEmu_ResetStats();
+
+	LCDEmu_Begin("LCD_Clear");
+	LCD_Clear(Black);
+	LCDEmu_End();
+
+	/* The walls, the paddle and the ball */
+	Rect(0, 0, WALL, MAX_Y, Red);
+	Rect(MAX_X - WALL, 0, WALL, MAX_Y, Red);
+	Rect(0, 0, MAX_X, WALL, Red);
+	Rect(100, PADDLE_Y, PADDLE_W, PADDLE_H, Green);
+	Rect(150, 160, BALL_SIZE, BALL_SIZE, Green);
+
+	/* A dashed center line and a diagonal */
+	for(i = 0; i < MAX_X; i += 16)
+	{
+		Line(i, MAX_Y / 2, i + 8, MAX_Y / 2, Grey);
+	}
+	Line(WALL, WALL, MAX_X - WALL - 1, MAX_Y - 1, Blue);
+
+	/* The score, the record and a rotated title */
+	Text(8, 160, "0", White, 0);
+	Text(MAX_X - 90, 8, "Best: 100", White, 0);
+	Text(MAX_X - 20, 100, "PONG", Yellow, 90);
+
+	for(i = 0; i < 64; i++)
+	{
+		LCDEmu_Begin("LCD_SetPoint");
+		LCD_SetPoint(20 + i, 300, Cyan);
+		LCDEmu_End();
+	}
+
+	LCDEmu_PrintStats(stdout);
+
+	Expect(0, MAX_Y - 1, Red, "left wall");
+	Expect(MAX_X - 1, MAX_Y / 3, Red, "right wall");
+	Expect(MAX_X / 3, 0, Red, "top wall");
+	Expect(100, PADDLE_Y, Green, "paddle");
+	Expect(100 + PADDLE_W - 1, PADDLE_Y + PADDLE_H - 1, Green, "paddle");
+	Expect(100 + PADDLE_W, PADDLE_Y, Black, "right of the paddle");
+	Expect(152, 162, Green, "ball");
+	Expect(16, MAX_Y / 2, Grey, "center line");
+	Expect(83, 300, Cyan, "points");
+
+	if(LCDEmu_DumpPPM(path) != 0)
+	{
+		printf("FAIL: cannot write %s\n", path);
+		fails++;
+	}
+	else
+	{
+		printf("frame in %s\n", path);
+	}
+	printf("%u failures\n", (unsigned)fails);
+	return fails != 0;
+}
+
+/******************************************************************************
+**                            End Of File
+******************************************************************************/
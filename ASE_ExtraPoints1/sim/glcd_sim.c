@@ -0,0 +1,118 @@
+/*********************************************************************************************************
+**--------------File Info---------------------------------------------------------------------------------
+** File name:           glcd_sim.c
+** Last modified Date:  2026-10-17
+** Last Version:        V1.00
+** Descriptions:        host test of the GRAM burst of GLCD/GLCD.c on the ILI9325 model: a pixel of
+**                      LCD_PushPixels must cost one data cycle and the GPIO writes of the data, the
+**                      latch and WR only, and land where the window puts it
+** Correlated files:    GLCD.c, GLCD_emu.c
+**--------------------------------------------------------------------------------------------------------
+*********************************************************************************************************/
+#include <stdio.h>
+#include "../GLCD/GLCD.h"
+#include "../GLCD/GLCD_emu.h"
+
+#if !defined(GLCD_EMULATOR) || !defined(GLCD_STATS)
+#error "build with -DGLCD_EMULATOR -DGLCD_STATS"
+#endif
+
+/* GPIO writes of a pixel in a burst: two bytes on P2, the latch, WR */
+#define PIXEL_GPIO		6
+/* Of a pixel of LCD_PushColor: the color stays on the bus, WR only */
+#define COLOR_GPIO		2
+
+static uint16_t pixels[MAX_X * 8];
+static uint32_t fails;
+
+/******************************************************************************
+** Function name:		Burst
+**
+** Descriptions:		One burst of LCD_PushPixels, or of LCD_PushColor, on a
+**									rectangle: its data cycles and GPIO writes per pixel
+**									against the limits, then the pixels in the GRAM
+**
+** parameters:			name: printed
+**									x, y, w, h: rectangle
+**									color: 0 for LCD_PushPixels, else the LCD_PushColor one
+** Returned value:		None
+**
+******************************************************************************/
+static void Burst(const char *name, uint16_t x, uint16_t y, uint16_t w, uint16_t h, uint16_t color)
+{
+	LCDEmu_Stats bus;
+	uint32_t n, i, gpio, limit = color ? COLOR_GPIO : PIXEL_GPIO;
+	uint16_t expect;
+
+	n = LCD_BeginWrite(x, y, w, h);
+	LCDEmu_ResetStats();
+	LCD_GpioWrites = 0;
+	if(color)
+		LCD_PushColor(color, n);
+	else
+		LCD_PushPixels(pixels, n);
+	gpio = LCD_GpioWrites;
+	LCDEmu_GetStats(&bus);
+	LCD_EndWrite();
+
+	printf("%-12s %6u pixels: %u data cycles, %u index cycles, %.2f GPIO writes per pixel\n",
+		name, (unsigned)n, (unsigned)bus.data_writes, (unsigned)bus.index_writes, (double)gpio / n);
+	if(bus.data_writes != n || bus.pixels != n || bus.index_writes != 0 || bus.data_reads != 0)
+	{
+		printf("FAIL: %s: not one data cycle per pixel\n", name);
+		fails++;
+	}
+	/* The color of LCD_PushColor is latched once: it may cost a few writes more */
+	if(gpio > limit * n + (color ? 4 : 0))
+	{
+		printf("FAIL: %s: %u GPIO writes for %u pixels, more than %u per pixel\n",
+			name, (unsigned)gpio, (unsigned)n, (unsigned)limit);
+		fails++;
+	}
+	for(i = 0; i < n; i++)
+	{
+		expect = color ? color : pixels[i];
+		if(LCDEmu_GetPixel(x + i % w, y + i / w) != expect)
+		{
+			printf("FAIL: %s: pixel %u at (%u, %u) is %04X, not %04X\n", name, (unsigned)i,
+				(unsigned)(x + i % w), (unsigned)(y + i / w), LCDEmu_GetPixel(x + i % w, y + i / w), expect);
+			fails++;
+			break;
+		}
+	}
+}
+
+int main(void)
+{
+	uint32_t i, single;
+
+	for(i = 0; i < sizeof(pixels) / sizeof(pixels[0]); i++)
+	{
+		pixels[i] = (uint16_t)(i * 2654435761u >> 16);
+	}
+	LCD_Initialization();
+	LCD_Clear(Black);
+
+	/* The cost the burst saves: one pixel on its own */
+	LCD_GpioWrites = 0;
+	LCD_SetPoint(10, 10, White);
+	single = LCD_GpioWrites;
+	printf("LCD_SetPoint %6u pixel:  %u GPIO writes\n", 1u, (unsigned)single);
+
+	Burst("row", 0, 100, MAX_X, 1, 0);
+	Burst("glyph", 17, 33, 8, 16, 0);
+	Burst("band", 0, 200, MAX_X, 8, 0);
+	Burst("fill", 30, 40, 50, 60, Red);
+
+	if(single <= PIXEL_GPIO)
+	{
+		printf("FAIL: a single pixel costs %u GPIO writes, a burst should save on it\n", (unsigned)single);
+		fails++;
+	}
+	printf("%u failures\n", (unsigned)fails);
+	return fails != 0;
+}
+
+/******************************************************************************
+**                            End Of File
+******************************************************************************/
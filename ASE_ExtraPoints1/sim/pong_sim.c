@@ -0,0 +1,362 @@
+/*********************************************************************************************************
+**--------------File Info---------------------------------------------------------------------------------
+** File name:           pong_sim.c
+** Last modified Date:  2026-10-17
+** Last Version:        V1.00
+** Descriptions:        headless host run of the game rules in MyLib/game.c: ADC samples from a
+**                      trace or from an automatic player, invariant checks and step timing
+** Correlated files:    game.c, ball.c, collide.c, recorder.c
+**--------------------------------------------------------------------------------------------------------
+*********************************************************************************************************/
+#define _POSIX_C_SOURCE 199309L
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include "../MyLib/game.h"
+#include "../MyLib/recorder.h"
+
+/* Longest ADC trace, one sample per line */
+#define MAX_TRACE			65536
+
+/* Step times are kept with a 1 ns resolution up to this, the rest in the last bucket */
+#define TIME_BUCKETS	4096
+
+static uint16_t trace[MAX_TRACE];
+static uint32_t trace_len;
+
+static uint64_t time_hist[TIME_BUCKETS];
+static uint32_t fails;
+
+/******************************************************************************
+** Function name:		LoadTrace
+**
+** Descriptions:		Read an ADC trace: one sample from 0 to 4095 per line,
+**									lines starting with # are comments
+**
+** parameters:			path: trace file
+** Returned value:		number of samples, 0 on error
+**
+******************************************************************************/
+static uint32_t LoadTrace(const char *path)
+{
+	char line[64];
+	FILE *f = fopen(path, "r");
+
+	if(f == NULL)
+	{
+		perror(path);
+		return 0;
+	}
+	while(trace_len < MAX_TRACE && fgets(line, sizeof(line), f) != NULL)
+	{
+		if(line[0] != '#' && line[0] != '\n')
+		{
+			trace[trace_len++] = (uint16_t)(strtoul(line, NULL, 0) & 0xFFF);
+		}
+	}
+	fclose(f);
+	return trace_len;
+}
+
+/******************************************************************************
+** Function name:		AutoPlayer
+**
+** Descriptions:		ADC sample that puts the paddle under the lowest ball that
+**									comes down, off by a random error so that some are missed
+**
+** parameters:			None
+** Returned value:		ADC sample
+**
+******************************************************************************/
+static uint16_t AutoPlayer(void)
+{
+	const BallPool *balls = &game.balls;
+	int i, ball = 0, x;
+
+	for(i = 1; i < balls->count; i++)
+	{
+		if((balls->vy[i] > 0 && balls->vy[ball] <= 0) ||
+			 ((balls->vy[i] > 0) == (balls->vy[ball] > 0) && balls->y[i] > balls->y[ball]))
+		{
+			ball = i;
+		}
+	}
+	x = Pool_Right(balls, ball) - 2 - 20 + rand() % 61 - 30;
+
+	if(x < 6)
+	{
+		x = 6;
+	}
+	else if(x > MAX_X - 46)
+	{
+		x = MAX_X - 46;
+	}
+	return (uint16_t)((x - 6) * (MAX_PADDLE - MIN_PADDLE) / (MAX_X - 52) + MIN_PADDLE);
+}
+
+/******************************************************************************
+** Function name:		Check
+**
+** Descriptions:		Count a broken invariant, the first ones are printed
+**
+** parameters:			ok: invariant, frame: step number, what: description
+** Returned value:		None
+**
+******************************************************************************/
+static void Check(int ok, uint64_t frame, const char *what)
+{
+	if(!ok && fails++ < 10)
+	{
+		printf("frame %llu: %s (balls %u paddle %u score %d)\n", (unsigned long long)frame, what,
+			game.balls.count, game.paddle_x, game.score);
+	}
+}
+
+static uint64_t Now(void)
+{
+	struct timespec ts;
+
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return (uint64_t)ts.tv_sec * 1000000000u + ts.tv_nsec;
+}
+
+/******************************************************************************
+** Function name:		Percentile
+**
+** Descriptions:		Step time under which a share of the steps ran
+**
+** parameters:			frames: steps timed, per_mille: share
+** Returned value:		ns
+**
+******************************************************************************/
+static uint32_t Percentile(uint64_t frames, uint32_t per_mille)
+{
+	uint64_t seen = 0, want = frames * per_mille / 1000;
+	uint32_t ns;
+
+	for(ns = 0; ns < TIME_BUCKETS - 1; ns++)
+	{
+		seen += time_hist[ns];
+		if(seen > want)
+		{
+			break;
+		}
+	}
+	return ns;
+}
+
+/* Recording written by -o, as the board sends it on the UART */
+static FILE *rec_file;
+
+static void PutFile(char c)
+{
+	fputc(c, rec_file);
+}
+
+/******************************************************************************
+** Function name:		Replay
+**
+** Descriptions:		Play a recording exported by the board, or by -o, again
+**									from its first snapshot and check that every later snapshot
+**									and the last state come out the same
+**
+** parameters:			path: recording
+** Returned value:		0 if the replay matches the recording
+**
+******************************************************************************/
+static int Replay(const char *path)
+{
+	char line[2 * sizeof(GameState) + 16];
+	uint8_t bytes[sizeof(GameState)];
+	GameState state;
+	uint32_t steps = 0, at, hash, keys = 0, mismatch = 0, i;
+	int started = 0, ended = 0;
+	FILE *f = fopen(path, "r");
+
+	if(f == NULL)
+	{
+		perror(path);
+		return 2;
+	}
+	while(fgets(line, sizeof(line), f) != NULL)
+	{
+		if(strncmp(line, "state ", 6) == 0 && strlen(line) >= 6 + 2 * sizeof(GameState))
+		{
+			for(i = 0; i < sizeof(GameState); i++)
+			{
+				sscanf(line + 6 + 2 * i, "%2hhx", &bytes[i]);
+			}
+			memcpy(&state, bytes, sizeof(state));
+			Game_Restore(&state);
+			started = 1;
+		}
+		else if(sscanf(line, "key %u %x", &at, &hash) == 2)
+		{
+			keys++;
+			mismatch += Game_Hash(&game) != hash;
+		}
+		else if(sscanf(line, "end %u %x", &at, &hash) == 2)
+		{
+			mismatch += Game_Hash(&game) != hash;
+			ended = 1;
+		}
+		else if(started && line[0] >= '0' && line[0] <= '9')
+		{
+			Game_Step((uint16_t)strtoul(line, NULL, 0));
+			steps++;
+		}
+	}
+	fclose(f);
+	if(!started || !ended)
+	{
+		fprintf(stderr, "%s: not a whole recording\n", path);
+		return 2;
+	}
+	printf("replay %u steps, %u snapshots and the end state checked, %u mismatches, ", steps, keys, mismatch);
+	printf("score %d, record %d", game.score, game.record);
+	printf("\n");
+	return mismatch != 0;
+}
+
+int main(int argc, char **argv)
+{
+	uint64_t frames = 10000000, frame, t0, dt, start, total = 0, max_time = 0, lost = 0;
+	uint32_t events, games = 0, hits = 0, best = 0, seed = 1;
+	int prev_score, prev_record, i, b;
+	const char *csv_path = NULL, *rec_path = NULL;
+	FILE *csv = NULL;
+
+	for(i = 1; i < argc; i++)
+	{
+		if(strcmp(argv[i], "-n") == 0 && i + 1 < argc)
+		{
+			frames = strtoull(argv[++i], NULL, 0);
+		}
+		else if(strcmp(argv[i], "-s") == 0 && i + 1 < argc)
+		{
+			seed = strtoul(argv[++i], NULL, 0);
+		}
+		else if(strcmp(argv[i], "-b") == 0 && i + 1 < argc)
+		{
+			Game_SetBalls((uint16_t)strtoul(argv[++i], NULL, 0));
+		}
+		else if(strcmp(argv[i], "-p") == 0 && i + 1 < argc)
+		{
+			return Replay(argv[++i]);
+		}
+		else if(strcmp(argv[i], "-o") == 0 && i + 1 < argc)
+		{
+			rec_path = argv[++i];
+		}
+		else if(strcmp(argv[i], "-t") == 0 && i + 1 < argc)
+		{
+			csv_path = argv[++i];
+		}
+		else if(argv[i][0] == '-' || LoadTrace(argv[i]) == 0)
+		{
+			fprintf(stderr, "usage: %s [-n steps] [-s seed] [-b balls] [-t timing.csv] [-o recording.txt] [-p recording.txt] [adc_trace.txt]\n", argv[0]);
+			return 2;
+		}
+	}
+	if(csv_path != NULL && (csv = fopen(csv_path, "w")) == NULL)
+	{
+		perror(csv_path);
+		return 2;
+	}
+	if(csv != NULL)
+	{
+		fprintf(csv, "frame,ns,events\n");
+	}
+	if(rec_path != NULL && (rec_file = fopen(rec_path, "w")) == NULL)
+	{
+		perror(rec_path);
+		return 2;
+	}
+	srand(seed);
+
+	Game_Start();
+	Game_Serve();
+	prev_score = game.score;
+	prev_record = game.record;
+	Recorder_Start();
+	start = Now();
+	for(frame = 0; frame < frames; frame++)
+	{
+		uint16_t sample = trace_len ? trace[frame % trace_len] : AutoPlayer();
+
+		if(rec_file != NULL)
+		{
+			Recorder_Step(sample);
+		}
+		t0 = Now();
+		events = Game_Step(sample);
+		dt = Now() - t0;
+
+		total += dt;
+		if(dt > max_time)
+		{
+			max_time = dt;
+		}
+		time_hist[dt < TIME_BUCKETS ? dt : TIME_BUCKETS - 1]++;
+		if(csv != NULL)
+		{
+			fprintf(csv, "%llu,%llu,%u\n", (unsigned long long)frame, (unsigned long long)dt, events);
+		}
+
+		/* The balls never leave the field, the numbers never go down */
+		for(b = 0; b < game.balls.count; b++)
+		{
+			Check(Pool_Left(&game.balls, b) >= MIN_BALLX && Pool_Right(&game.balls, b) <= MAX_BALLX, frame, "ball out of the walls");
+			Check(Pool_Top(&game.balls, b) >= MIN_BALLY, frame, "ball above the top wall");
+		}
+		Check(((events & GAME_OVER) != 0) == (game.balls.count == 0), frame, "game over with balls in play");
+		Check(game.paddle_x >= 6 && game.paddle_x <= MAX_X - 46, frame, "paddle out of its run");
+		Check(game.score >= prev_score && game.record >= prev_record, frame, "score or record went down");
+		Check(((events & GAME_HIT) != 0) == (game.score != prev_score), frame, "score changed without a hit");
+		prev_score = game.score;
+		prev_record = game.record;
+
+		if(events & GAME_HIT)
+		{
+			hits++;
+		}
+		if(events & GAME_OVER)
+		{
+			/* -o keeps the first game */
+			if(rec_file != NULL)
+			{
+				Recorder_Stop();
+				/* A FIFO of the UART at a time, as on the board */
+				while(Recorder_Export(PutFile, 16));
+				fclose(rec_file);
+				rec_file = NULL;
+			}
+			games++;
+			lost += game.lost;
+			if((uint32_t)game.score > best)
+			{
+				best = game.score;
+			}
+			Game_Start();
+			Game_Serve();
+			prev_score = game.score;
+		}
+	}
+	dt = Now() - start;
+	if(csv != NULL)
+	{
+		fclose(csv);
+	}
+
+	printf("balls %u, steps %llu in %.3f s: %.2f M steps/s\n", game.served, (unsigned long long)frames, dt / 1e9, frames / (dt / 1e3));
+	printf("games %u, paddle hits %u, balls lost %llu, best score %d, record %d\n", games, hits,
+		(unsigned long long)lost, best, game.record);
+	if(frames > 0)
+	{
+		printf("step time ns: mean %.1f, p50 %u, p99 %u, p99.9 %u, max %llu\n", (double)total / frames,
+			Percentile(frames, 500), Percentile(frames, 990), Percentile(frames, 999), (unsigned long long)max_time);
+	}
+	printf("invariant failures %u\n", fails);
+	return fails != 0;
+}
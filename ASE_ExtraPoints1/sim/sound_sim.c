@@ -0,0 +1,316 @@
+/*********************************************************************************************************
+**--------------File Info---------------------------------------------------------------------------------
+** File name:           sound_sim.c
+** Last modified Date:  2026-10-17
+** Last Version:        V1.00
+** Descriptions:        host run of the sound effects of MyLib/sound.c: the blocks the GPDMA would
+**                      play, checked against the notes, the queue of the effects and a WAV file
+**                      of an effect
+** Correlated files:    sound.c, lib_dac.c
+**--------------------------------------------------------------------------------------------------------
+*********************************************************************************************************/
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "../MyLib/sound.h"
+
+/* Rate of the WAV files */
+#define WAV_RATE		44100
+
+static const char *const names[SOUND_EFFECTS] = { "none", "wall", "paddle", "score", "lose" };
+
+static uint32_t block[SOUND_BLOCK];
+static uint32_t fails;
+
+/******************************************************************************
+** Function name:		CheckWave
+**
+** Descriptions:		The block holds SOUND_PERIODS equal periods of 10 bit
+**									DACR values, and the silence is where a period starts
+**
+** parameters:			None
+** Returned value:		None
+**
+******************************************************************************/
+static void CheckWave(void)
+{
+	int i;
+
+	Sound_Wave(block);
+	for(i = 0; i < SOUND_BLOCK; i++)
+	{
+		if((block[i] & ~(0x3FFu << 6)) != 0 || block[i] != block[i % SOUND_SAMPLES])
+		{
+			printf("FAIL wave: word %d is 0x%08x\n", i, (unsigned)block[i]);
+			fails++;
+			return;
+		}
+	}
+	if(Sound_Silence() != block[0])
+	{
+		printf("FAIL wave: silence 0x%08x, the sine starts at 0x%08x\n", (unsigned)Sound_Silence(), (unsigned)block[0]);
+		fails++;
+	}
+}
+
+/******************************************************************************
+** Function name:		RunEffect
+**
+** Descriptions:		Play an effect the way Sound_Block does, one block per
+**									interrupt, and write it as 16 bit PCM if out is not NULL
+**
+** parameters:			effect: SOUND_*
+**									out: WAV data, or NULL
+** Returned value:		samples written to out
+**
+******************************************************************************/
+static uint32_t RunEffect(uint16_t effect, FILE *out)
+{
+	SoundSeq seq;
+	uint32_t next, blocks = 0, written = 0, i;
+	double t = 0, t_out = 0, sample_time;
+	int16_t pcm;
+
+	Sound_Start(&seq, effect);
+	while((next = Sound_NextBlock(&seq)) != 0)
+	{
+		if((next & 0xFFFF) == 0 || (next & ~(SOUND_REST | 0xFFFF)) != 0)
+		{
+			printf("FAIL %s: block %u has DACCNTVAL 0x%x\n", names[effect], (unsigned)blocks, (unsigned)next);
+			fails++;
+			return written;
+		}
+		sample_time = (double)(next & 0xFFFF) / SOUND_CLOCK;
+		for(i = 0; out != NULL && i < SOUND_BLOCK; i++)
+		{
+			/* The DAC holds a word for a timeout of its counter */
+			pcm = (int16_t)(((next & SOUND_REST) ? 0 : (int)(block[i] >> 6) - (int)(block[0] >> 6)) * 32);
+			for(t += sample_time; t_out < t; t_out += 1.0 / WAV_RATE)
+			{
+				fwrite(&pcm, sizeof(pcm), 1, out);
+				written++;
+			}
+		}
+		blocks++;
+		if(blocks > 100000)
+		{
+			printf("FAIL %s: it does not end\n", names[effect]);
+			fails++;
+			break;
+		}
+	}
+	return written;
+}
+
+/******************************************************************************
+** Function name:		CheckEffect
+**
+** Descriptions:		Each note of the effect plays at its pitch within 1% and
+**									lasts its time within half a block; print the totals
+**
+** parameters:			effect: SOUND_*
+** Returned value:		None
+**
+******************************************************************************/
+static void CheckEffect(uint16_t effect)
+{
+	SoundSeq seq;
+	const Note *note = NULL;
+	uint32_t next, blocks = 0, count = 0;
+	double note_time = 0, total = 0, freq, block_time;
+
+	Sound_Start(&seq, effect);
+	for(;;)
+	{
+		next = Sound_NextBlock(&seq);
+		/* A note is over: check its time */
+		if(note != NULL && (next == 0 || seq.note != note))
+		{
+			freq = note->freq != 0 ? note->freq : SOUND_REST_FREQ;
+			block_time = 1000.0 * SOUND_PERIODS / freq;
+			if(note_time < note->ms - block_time / 2 - 1)
+			{
+				printf("FAIL %s: a note of %u ms lasts %.1f ms\n", names[effect], note->ms, note_time);
+				fails++;
+			}
+			/* A note shorter than half a block still gets one */
+			if(note_time > note->ms + block_time / 2 + 1 && count > 1)
+			{
+				printf("FAIL %s: a note of %u ms lasts %.1f ms\n", names[effect], note->ms, note_time);
+				fails++;
+			}
+			note_time = 0;
+			count = 0;
+		}
+		if(next == 0)
+		{
+			break;
+		}
+		note = seq.note;
+		freq = (double)SOUND_CLOCK / ((next & 0xFFFF) * SOUND_SAMPLES);
+		if(!(next & SOUND_REST) && (freq < note->freq * 0.99 || freq > note->freq * 1.01))
+		{
+			printf("FAIL %s: a note of %u Hz plays at %.1f Hz\n", names[effect], note->freq, freq);
+			fails++;
+		}
+		block_time = 1000.0 * SOUND_BLOCK * (next & 0xFFFF) / SOUND_CLOCK;
+		note_time += block_time;
+		total += block_time;
+		count++;
+		blocks++;
+	}
+	if(effect == SOUND_NONE)
+	{
+		if(blocks != 0)
+		{
+			printf("FAIL none: %u blocks\n", (unsigned)blocks);
+			fails++;
+		}
+		return;
+	}
+	/* Interrupts per second of the GPDMA, TIMER0 took 45 in each period of the tone */
+	printf("%-8s %4u blocks %7.1f ms  %6.1f interrupts/s\n", names[effect], (unsigned)blocks, total,
+		total > 0 ? blocks * 1000.0 / total : 0.0);
+}
+
+/******************************************************************************
+** Function name:		Played
+**
+** Descriptions:		Run the player until it is quiet, as the GPDMA interrupt
+**									does, after the effects of hits were queued in one go
+**
+** parameters:			hits: effects queued, SOUND_NONE ends the list
+**									expect: effects that must play, in order, SOUND_NONE ends it
+** Returned value:		None
+**
+******************************************************************************/
+static void Played(const uint16_t *hits, const uint16_t *expect)
+{
+	SoundPlayer player;
+	uint16_t played[64], n = 0, i;
+	uint32_t next = 0;
+
+	Sound_Reset(&player);
+	for(i = 0; hits[i] != SOUND_NONE; i++)
+	{
+		if(Sound_Enqueue(&player, hits[i]))
+		{
+			next = Sound_Next(&player);
+			played[n++] = player.playing;
+		}
+	}
+	while(next != 0 && n < 64)
+	{
+		/* An effect starts when it leaves the queue */
+		i = player.queued;
+		next = Sound_Next(&player);
+		if(next != 0 && player.queued != i)
+		{
+			played[n++] = player.playing;
+		}
+	}
+	for(i = 0; i < n && expect[i] == played[i]; i++)
+		;
+	if(i != n || expect[n] != SOUND_NONE)
+	{
+		printf("FAIL queue: %u effects played, from %s to %s\n", (unsigned)n,
+			n ? names[played[0]] : "-", n ? names[played[n - 1]] : "-");
+		fails++;
+	}
+}
+
+/******************************************************************************
+** Function name:		CheckQueue
+**
+** Descriptions:		Bursts of hits: the same effect waiting is merged, a more
+**									important one takes the place of the ones waiting
+**
+** parameters:			None
+** Returned value:		None
+**
+******************************************************************************/
+static void CheckQueue(void)
+{
+	static const uint16_t walls[] = { SOUND_WALL, SOUND_WALL, SOUND_WALL, SOUND_WALL, SOUND_NONE };
+	static const uint16_t walls_played[] = { SOUND_WALL, SOUND_WALL, SOUND_NONE };
+	static const uint16_t mixed[] = { SOUND_WALL, SOUND_PADDLE, SOUND_WALL, SOUND_PADDLE, SOUND_NONE };
+	static const uint16_t mixed_played[] = { SOUND_WALL, SOUND_PADDLE, SOUND_WALL, SOUND_NONE };
+	static const uint16_t over[] = { SOUND_PADDLE, SOUND_WALL, SOUND_SCORE, SOUND_WALL, SOUND_LOSE, SOUND_NONE };
+	static const uint16_t over_played[] = { SOUND_PADDLE, SOUND_LOSE, SOUND_NONE };
+	static const uint16_t none[] = { SOUND_NONE };
+
+	Played(walls, walls_played);
+	Played(mixed, mixed_played);
+	Played(over, over_played);
+	Played(none, none);
+}
+
+/******************************************************************************
+** Function name:		WriteWav
+**
+** Descriptions:		Write an effect as a mono 16 bit WAV file
+**
+** parameters:			path: WAV file
+**									effect: SOUND_*
+** Returned value:		0 on error
+**
+******************************************************************************/
+static int WriteWav(const char *path, uint16_t effect)
+{
+	FILE *f = fopen(path, "wb");
+	uint32_t samples, v;
+	uint16_t w;
+
+	if(f == NULL)
+	{
+		perror(path);
+		return 0;
+	}
+	fseek(f, 44, SEEK_SET);
+	samples = RunEffect(effect, f);
+	fseek(f, 0, SEEK_SET);
+	fwrite("RIFF", 1, 4, f);
+	v = 36 + samples * 2; fwrite(&v, 4, 1, f);
+	fwrite("WAVEfmt ", 1, 8, f);
+	v = 16; fwrite(&v, 4, 1, f);
+	w = 1; fwrite(&w, 2, 1, f);
+	w = 1; fwrite(&w, 2, 1, f);
+	v = WAV_RATE; fwrite(&v, 4, 1, f);
+	v = WAV_RATE * 2; fwrite(&v, 4, 1, f);
+	w = 2; fwrite(&w, 2, 1, f);
+	w = 16; fwrite(&w, 2, 1, f);
+	fwrite("data", 1, 4, f);
+	v = samples * 2; fwrite(&v, 4, 1, f);
+	fclose(f);
+	return 1;
+}
+
+int main(int argc, char **argv)
+{
+	uint16_t effect;
+	int i;
+
+	CheckWave();
+	for(effect = 0; effect < SOUND_EFFECTS; effect++)
+	{
+		CheckEffect(effect);
+	}
+	CheckQueue();
+	/* -w file effect: write the effect as a WAV file */
+	for(i = 1; i + 2 < argc; i += 3)
+	{
+		if(strcmp(argv[i], "-w") != 0)
+		{
+			break;
+		}
+		for(effect = 0; effect < SOUND_EFFECTS && strcmp(names[effect], argv[i + 2]) != 0; effect++)
+			;
+		if(effect == SOUND_EFFECTS || !WriteWav(argv[i + 1], effect))
+		{
+			fprintf(stderr, "usage: %s [-w file.wav effect]...\n", argv[0]);
+			return 2;
+		}
+	}
+	printf("%u failures\n", (unsigned)fails);
+	return fails != 0;
+}
@@ -0,0 +1,35 @@
+/*********************************************************************************************************
+**--------------File Info---------------------------------------------------------------------------------
+** File name:           IRQ_systick.c
+** Last modified Date:  2026-10-17
+** Last Version:        V1.00
+** Descriptions:        functions to manage SysTick interrupts
+** Correlated files:    systick.h
+**--------------------------------------------------------------------------------------------------------
+*********************************************************************************************************/
+#include "lpc17xx.h"
+#include "systick.h"
+#include "../input/input.h"
+
+/* Ticks since init_SysTick, one per ms with the interval set in sample.c */
+volatile uint32_t systick_ms = 0;
+
+/******************************************************************************
+** Function name:		SysTick_Handler
+**
+** Descriptions:		SysTick interrupt handler, it also polls the joystick
+**
+** parameters:			None
+** Returned value:		None
+**
+******************************************************************************/
+void SysTick_Handler (void)
+{
+  systick_ms++;
+  Input_Poll();
+  return;
+}
+
+/******************************************************************************
+**                            End Of File
+******************************************************************************/
@@ -0,0 +1,23 @@
+/*********************************************************************************************************
+**--------------File Info---------------------------------------------------------------------------------
+** File name:           systick.h
+** Last modified Date:  2026-10-17
+** Last Version:        V1.00
+** Descriptions:        Prototypes of functions included in the lib_systick, IRQ_systick .c files
+** Correlated files:    lib_systick.c, IRQ_systick.c
+**--------------------------------------------------------------------------------------------------------
+*********************************************************************************************************/
+#ifndef __SYSTICK_H
+#define __SYSTICK_H
+
+/* lib_systick.c */
+extern uint32_t init_SysTick( uint32_t SysTickInterval );
+extern uint32_t read_SysTick_us( void );
+/* IRQ_systick.c */
+extern volatile uint32_t systick_ms;
+extern void SysTick_Handler (void);
+
+#endif /* end __SYSTICK_H */
+/*****************************************************************************
+**                            End Of File
+******************************************************************************/
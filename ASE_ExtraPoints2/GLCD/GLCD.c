@@ -22,9 +22,22 @@
 /* Includes ------------------------------------------------------------------*/
 #include "GLCD.h" 
 #include "AsciiLib.h"
+#ifdef GLCD_EMULATOR
+#include "GLCD_emu.h"
+#endif
 
 /* Private variables ---------------------------------------------------------*/
 static uint8_t LCD_Code;
+static uint8_t LCD_Windowed;	/* 1 when the GRAM window is not the full screen */
+
+#ifndef GLCD_EMULATOR
+static uint32_t LCD_BootTicks;	/* core clocks counted by LCD_Ticks since LCD_Initialization */
+static uint32_t LCD_LastTick;	/* SysTick value seen by the previous LCD_Ticks */
+#endif
+
+#ifdef GLCD_STATS
+volatile uint32_t LCD_GpioWrites;	/* GPIO writes issued to the LCD bus */
+#endif
 
 /* Private define ------------------------------------------------------------*/
 #define  ILI9320    0  /* 0x9320 */
@@ -43,6 +56,36 @@ static uint8_t LCD_Code;
 #define  LGDP4535   13 /* 0x4535 */  
 #define  SSD2119    14 /* 3.5 LCD 0x9919 */
 
+/* SysTick runs free during the boot, without interrupts, to time the delays */
+#define  SYSTICK_ENABLE     (1 << 0)
+#define  SYSTICK_CLKSOURCE  (1 << 2)	/* count core clocks */
+#define  SYSTICK_MAX        0x00FFFFFF
+
+/*
+ * Delays of the power on sequence of the ILI9325 datasheet, in real ms. Only
+ * the supply steps wait: the reset one is a bound, the controller is polled
+ */
+#define  LCD_RESET_DELAY    100	/* ms at most from power up to a readable driver code */
+#define  LCD_POWER_DELAY    50	/* ms for each power supply step to settle */
+
+/* Entry mode (R03) bits of the ILI932x family */
+#define  ENTRY_BGR		(1 << 12)
+#define  ENTRY_ID1		(1 << 5)	/* vertical increment 	*/
+#define  ENTRY_ID0		(1 << 4)	/* horizontal increment */
+#define  ENTRY_AM		(1 << 3)	/* vertical first 		*/
+#define  ENTRY_DEFAULT	( ENTRY_BGR | ENTRY_ID1 | ENTRY_ID0 )
+
+/*
+ * Both builds run the same GPIO sequences, so LCD_GPIO_COUNT counts the same
+ * writes: the host one stores to the stand-ins of GLCD_emu.h and hands each
+ * bus cycle to the ILI9325 model of GLCD_emu.c when WR or RD completes it
+ */
+#ifdef GLCD_EMULATOR
+#define  LCD_BUS(access)	(access)
+#else
+#define  LCD_BUS(access)	((void)0)
+#endif
+
 /*******************************************************************************
 * Function Name  : Lcd_Configuration
 * Description    : Configures LCD Control lines
@@ -59,6 +102,7 @@ static void LCD_Configuration(void)
 	/* RS = P0.23 , WR = P0.24 , RD = P0.25 , DB[0.7] = P2.0...P2.7 , DB[8.15]= P2.0...P2.7 */  
 	LPC_GPIO0->FIODIR   |= 0x03f80000;
 	LPC_GPIO0->FIOSET    = 0x03f80000;
+	LCD_BUS(LCDEmu_Init());
 }
 
 /*******************************************************************************
@@ -69,7 +113,7 @@ static void LCD_Configuration(void)
 * Return         : None
 * Attention		 : None
 *******************************************************************************/
-static __attribute__((always_inline)) void LCD_Send (uint16_t byte) 
+static __inline __attribute__((always_inline)) void LCD_Send (uint16_t byte) 
 {
 	LPC_GPIO2->FIODIR |= 0xFF;          /* P2.0...P2.7 Output */
 	LCD_DIR(1)		   				    				/* Interface A->B */
@@ -78,6 +122,7 @@ static __attribute__((always_inline)) void LCD_Send (uint16_t byte)
 	LCD_LE(1)                         
 	LCD_LE(0)														/* latch D0..D7	*/
 	LPC_GPIO2->FIOPIN =  byte >> 8;     /* Write D8..D15 */
+	LCD_GPIO_COUNT(3);
 }
 
 /*******************************************************************************
@@ -102,11 +147,12 @@ static void wait_delay(int count)
 * Return         : ضȡ
 * Attention		 : None
 *******************************************************************************/
-static __attribute__((always_inline)) uint16_t LCD_Read (void) 
+static __inline __attribute__((always_inline)) uint16_t LCD_Read (void) 
 {
 	uint16_t value;
 	
 	LPC_GPIO2->FIODIR &= ~(0xFF);              /* P2.0...P2.7 Input */
+	LCD_GPIO_COUNT(1);
 	LCD_DIR(0);		   				           				 /* Interface B->A */
 	LCD_EN(0);	                               /* Enable 2B->2A */
 	wait_delay(30);							   						 /* delay some times */
@@ -114,6 +160,7 @@ static __attribute__((always_inline)) uint16_t LCD_Read (void)
 	LCD_EN(1);	                               /* Enable 1B->1A */
 	wait_delay(30);							   						 /* delay some times */
 	value = (value << 8) | LPC_GPIO2->FIOPIN0; /* Read D0..D7 */
+	LCD_BUS(value = LCDEmu_ReadData());
 	LCD_DIR(1);
 	return  value;
 }
@@ -126,7 +173,7 @@ static __attribute__((always_inline)) uint16_t LCD_Read (void)
 * Return         : None
 * Attention		 : None
 *******************************************************************************/
-static __attribute__((always_inline)) void LCD_WriteIndex(uint16_t index)
+static __inline __attribute__((always_inline)) void LCD_WriteIndex(uint16_t index)
 {
 	LCD_CS(0);
 	LCD_RS(0);
@@ -136,6 +183,7 @@ static __attribute__((always_inline)) void LCD_WriteIndex(uint16_t index)
 	LCD_WR(0);  
 	wait_delay(1);
 	LCD_WR(1);
+	LCD_BUS(LCDEmu_WriteIndex(index));
 	LCD_CS(1);
 }
 
@@ -147,7 +195,7 @@ static __attribute__((always_inline)) void LCD_WriteIndex(uint16_t index)
 * Return         : None
 * Attention		 : None
 *******************************************************************************/
-static __attribute__((always_inline)) void LCD_WriteData(uint16_t data)
+static __inline __attribute__((always_inline)) void LCD_WriteData(uint16_t data)
 {				
 	LCD_CS(0);
 	LCD_RS(1);   
@@ -155,6 +203,7 @@ static __attribute__((always_inline)) void LCD_WriteData(uint16_t data)
 	LCD_WR(0);     
 	wait_delay(1);
 	LCD_WR(1);
+	LCD_BUS(LCDEmu_WriteData(data));
 	LCD_CS(1);
 }
 
@@ -166,7 +215,7 @@ static __attribute__((always_inline)) void LCD_WriteData(uint16_t data)
 * Return         : ضȡ
 * Attention		 : None
 *******************************************************************************/
-static __attribute__((always_inline)) uint16_t LCD_ReadData(void)
+static __inline __attribute__((always_inline)) uint16_t LCD_ReadData(void)
 { 
 	uint16_t value;
 	
@@ -182,6 +231,7 @@ static __attribute__((always_inline)) uint16_t LCD_ReadData(void)
 	return value;
 }
 
+
 /*******************************************************************************
 * Function Name  : LCD_WriteReg
 * Description    : Writes to the selected LCD register.
@@ -191,7 +241,7 @@ static __attribute__((always_inline)) uint16_t LCD_ReadData(void)
 * Return         : None
 * Attention		 : None
 *******************************************************************************/
-static __attribute__((always_inline)) void LCD_WriteReg(uint16_t LCD_Reg,uint16_t LCD_RegValue)
+static __inline __attribute__((always_inline)) void LCD_WriteReg(uint16_t LCD_Reg,uint16_t LCD_RegValue)
 { 
 	/* Write 16-bit Index, then Write Reg */  
 	LCD_WriteIndex(LCD_Reg);         
@@ -207,7 +257,7 @@ static __attribute__((always_inline)) void LCD_WriteReg(uint16_t LCD_Reg,uint16_
 * Return         : LCD Register Value.
 * Attention		 : None
 *******************************************************************************/
-static __attribute__((always_inline)) uint16_t LCD_ReadReg(uint16_t LCD_Reg)
+static __inline __attribute__((always_inline)) uint16_t LCD_ReadReg(uint16_t LCD_Reg)
 {
 	uint16_t LCD_RAM;
 	
@@ -269,23 +319,159 @@ static void LCD_SetCursor(uint16_t Xpos,uint16_t Ypos)
 }
 
 /*******************************************************************************
-* Function Name  : LCD_Delay
-* Description    : Delay Time
-* Input          : - nCount: Delay Time
+* Function Name  : LCD_SetWindow
+* Description    : Sets the GRAM window and moves the cursor to its top-left
+*                  corner, so that the following writes to 0x22 auto-increment
+*                  inside the rectangle.
+* Input          : - Xpos: left column of the window
+*                  - Ypos: top row of the window
+*                  - Width: window width, in pixels
+*                  - Height: window height, in pixels
 * Output         : None
 * Return         : None
+* Attention		 : the caller must clip the rectangle to the screen
+*******************************************************************************/
+static void LCD_SetWindow(uint16_t Xpos, uint16_t Ypos, uint16_t Width, uint16_t Height)
+{
+	uint16_t x0, y0, x1, y1;
+
+    #if  ( DISP_ORIENTATION == 90 ) || ( DISP_ORIENTATION == 270 )
+
+	x0 = Ypos;
+	x1 = Ypos + Height - 1;
+	y0 = ( MAX_X - 1 ) - ( Xpos + Width - 1 );
+	y1 = ( MAX_X - 1 ) - Xpos;
+
+	#elif  ( DISP_ORIENTATION == 0 ) || ( DISP_ORIENTATION == 180 )
+
+	x0 = Xpos;
+	x1 = Xpos + Width - 1;
+	y0 = Ypos;
+	y1 = Ypos + Height - 1;
+
+	#endif
+
+  switch( LCD_Code )
+  {
+     default:		 /* 0x9320 0x9325 0x9328 0x9331 0x5408 0x1505 0x0505 0x7783 0x4531 0x4535 */
+          LCD_WriteReg(0x0050, x0 );
+          LCD_WriteReg(0x0051, x1 );
+          LCD_WriteReg(0x0052, y0 );
+          LCD_WriteReg(0x0053, y1 );
+          LCD_WriteReg(0x0020, x0 );
+          LCD_WriteReg(0x0021, y0 );
+	      break;
+
+     case SSD1298: 	 /* 0x8999 */
+     case SSD1289:   /* 0x8989 */
+          LCD_WriteReg(0x0044, ( x1 << 8 ) | x0 );
+          LCD_WriteReg(0x0045, y0 );
+          LCD_WriteReg(0x0046, y1 );
+	      LCD_WriteReg(0x004e, x0 );
+          LCD_WriteReg(0x004f, y0 );
+	      break;
+
+     case HX8346A: 	 /* 0x0046 */
+     case HX8347A: 	 /* 0x0047 */
+     case HX8347D: 	 /* 0x0047 */
+	      LCD_WriteReg(0x02, x0>>8 );
+	      LCD_WriteReg(0x03, x0 );
+	      LCD_WriteReg(0x04, x1>>8 );
+	      LCD_WriteReg(0x05, x1 );
+	      LCD_WriteReg(0x06, y0>>8 );
+	      LCD_WriteReg(0x07, y0 );
+	      LCD_WriteReg(0x08, y1>>8 );
+	      LCD_WriteReg(0x09, y1 );
+	      break;
+     case SSD2119:	 /* 3.5 LCD 0x9919 */
+	      break;
+  }
+
+	LCD_Windowed = ( Xpos != 0 || Ypos != 0 || Width != MAX_X || Height != MAX_Y );
+}
+
+/*******************************************************************************
+* Function Name  : LCD_ResetWindow
+* Description    : Restores the full screen GRAM window, if a smaller one is set
+* Input          : None
+* Output         : None
 * Return         : None
-* Attention		 : None
+* Attention		 : the cursor must be within the window for single pixel access
+*******************************************************************************/
+static __inline __attribute__((always_inline)) void LCD_ResetWindow(void)
+{
+	if( LCD_Windowed )
+	{
+		LCD_SetWindow(0, 0, MAX_X, MAX_Y);
+	}
+}
+
+#ifndef GLCD_EMULATOR
+
+/*******************************************************************************
+* Function Name  : LCD_Ticks
+* Description    : Core clocks elapsed since LCD_Initialization, accumulated from
+*                  the free running SysTick down counter
+* Input          : None
+* Output         : None
+* Return         : clocks
+* Attention		 : SysTick wraps every 2^24 clocks (167 ms at 100 MHz), it must
+*                  be read at least that often to stay exact
+*******************************************************************************/
+static uint32_t LCD_Ticks(void)
+{
+	uint32_t now = SysTick->VAL;
+
+	LCD_BootTicks += ( LCD_LastTick - now ) & SYSTICK_MAX;
+	LCD_LastTick = now;
+	return LCD_BootTicks;
+}
+
+/*******************************************************************************
+* Function Name  : LCD_Delay
+* Description    : Delay Time, exact to the core clock
+* Input          : - ms: Delay Time
+* Output         : None
+* Return         : None
+* Attention		 : Needs the SysTick started by LCD_Initialization
 *******************************************************************************/
 static void delay_ms(uint16_t ms)    
 { 
-	uint16_t i,j; 
-	for( i = 0; i < ms; i++ )
-	{ 
-		for( j = 0; j < 1141; j++ );
-	}
+	uint32_t end = LCD_Ticks() + ms * ( SystemFrequency / 1000 );
+
+	while( (int32_t)( LCD_Ticks() - end ) < 0 );
 } 
 
+/*******************************************************************************
+* Function Name  : LCD_WaitReady
+* Description    : Polls the driver code (R00) until the controller answers with
+*                  a known one, instead of sitting through the whole reset delay
+* Input          : None
+* Output         : None
+* Return         : the driver code, the last one read after LCD_RESET_DELAY ms
+*                  if the controller never answers with a known one
+* Attention		 : Needs the SysTick started by LCD_Initialization
+*******************************************************************************/
+static uint16_t LCD_WaitReady(void)
+{
+	uint32_t end = LCD_Ticks() + LCD_RESET_DELAY * ( SystemFrequency / 1000 );
+	uint16_t code;
+
+	do
+	{
+		code = LCD_ReadReg(0x0000);
+	} while( code != 0x9325 && code != 0x9328 && (int32_t)( LCD_Ticks() - end ) < 0 );
+	return code;
+}
+
+#else	/* GLCD_EMULATOR */
+
+/* The model has no power supply to wait for and answers right away */
+#define delay_ms(ms)	((void)(ms))
+#define LCD_WaitReady()	LCD_ReadReg(0x0000)
+
+#endif	/* GLCD_EMULATOR */
+
 
 /*******************************************************************************
 * Function Name  : LCD_Initializtion
@@ -299,9 +485,16 @@ void LCD_Initialization(void)
 {
 	uint16_t DeviceCode;
 	
+#ifndef GLCD_EMULATOR
+	SysTick->LOAD = SYSTICK_MAX;
+	SysTick->VAL = 0;
+	SysTick->CTRL = SYSTICK_CLKSOURCE | SYSTICK_ENABLE;
+	LCD_LastTick = SysTick->VAL;
+	LCD_BootTicks = 0;
+#endif
+
 	LCD_Configuration();
-	delay_ms(100);
-	DeviceCode = LCD_ReadReg(0x0000);		/* ȡID	*/	
+	DeviceCode = LCD_WaitReady();		/* ȡID	*/	
 	
 	if( DeviceCode == 0x9325 || DeviceCode == 0x9328 )	
 	{
@@ -310,7 +503,7 @@ void LCD_Initialization(void)
 		LCD_WriteReg(0x0000,0x0001);  	/* start internal osc */
 		LCD_WriteReg(0x0001,0x0100);     
 		LCD_WriteReg(0x0002,0x0700); 	/* power on sequence */
-		LCD_WriteReg(0x0003,(1<<12)|(1<<5)|(1<<4)|(0<<3) ); 	/* importance */
+		LCD_WriteReg(0x0003,ENTRY_DEFAULT); 	/* importance */
 		LCD_WriteReg(0x0004,0x0000);                                   
 		LCD_WriteReg(0x0008,0x0207);	           
 		LCD_WriteReg(0x0009,0x0000);         
@@ -323,19 +516,18 @@ void LCD_Initialization(void)
 		LCD_WriteReg(0x0011,0x0007);
 		LCD_WriteReg(0x0012,0x0000);                                                                 
 		LCD_WriteReg(0x0013,0x0000);                 
-		delay_ms(50);  /* delay 50 ms */		
+		delay_ms(LCD_POWER_DELAY);		
 		LCD_WriteReg(0x0010,0x1590);   
 		LCD_WriteReg(0x0011,0x0227);
-		delay_ms(50);  /* delay 50 ms */		
+		delay_ms(LCD_POWER_DELAY);		
 		LCD_WriteReg(0x0012,0x009c);                  
-		delay_ms(50);  /* delay 50 ms */		
+		delay_ms(LCD_POWER_DELAY);		
 		LCD_WriteReg(0x0013,0x1900);   
 		LCD_WriteReg(0x0029,0x0023);
 		LCD_WriteReg(0x002b,0x000e);
-		delay_ms(50);  /* delay 50 ms */		
+		delay_ms(LCD_POWER_DELAY);		
 		LCD_WriteReg(0x0020,0x0000);                                                            
 		LCD_WriteReg(0x0021,0x0000);           
-		delay_ms(50);  /* delay 50 ms */		
 		LCD_WriteReg(0x0030,0x0007); 
 		LCD_WriteReg(0x0031,0x0707);   
 		LCD_WriteReg(0x0032,0x0006);
@@ -346,7 +538,6 @@ void LCD_Initialization(void)
 		LCD_WriteReg(0x0039,0x0706);     
 		LCD_WriteReg(0x003c,0x0701);
 		LCD_WriteReg(0x003d,0x000f);
-		delay_ms(50);  /* delay 50 ms */		
 		LCD_WriteReg(0x0050,0x0000);        
 		LCD_WriteReg(0x0051,0x00ef);   
 		LCD_WriteReg(0x0052,0x0000);     
@@ -373,8 +564,28 @@ void LCD_Initialization(void)
 		LCD_WriteReg(0x0020,0x0000);  /* ַ0 */                                                          
 		LCD_WriteReg(0x0021,0x0000);  /* ַ0 */     
 	}
+	/* The gamma, window and display registers need no settling time */
+}
+
+/*******************************************************************************
+* Function Name  : LCD_FirstFrame
+* Description    : Marks the first frame as shown and stops the boot timer
+* Input          : None
+* Output         : None
+* Return         : microseconds from LCD_Initialization to this call
+* Attention		 : Call it within 167 ms of the end of LCD_Initialization, the
+*                  SysTick is not read in between; a full LCD_Clear fits
+*******************************************************************************/
+uint32_t LCD_FirstFrame(void)
+{
+#ifdef GLCD_EMULATOR
+	return 0;
+#else
+	uint32_t ticks = LCD_Ticks();
 
-    delay_ms(50);   /* delay 50 ms */	
+	SysTick->CTRL = 0;
+	return ticks / ( SystemFrequency / 1000000 );
+#endif
 }
 
 /*******************************************************************************
@@ -387,31 +598,159 @@ void LCD_Initialization(void)
 *******************************************************************************/
 void LCD_Clear(uint16_t Color)
 {
-	uint32_t index;
-	
-	if( LCD_Code == HX8347D || LCD_Code == HX8347A )
+	LCD_FillRect(0, 0, MAX_X, MAX_Y, Color);
+}
+
+/*******************************************************************************
+* Function Name  : LCD_StartWrite
+* Description    : Selects the GRAM and sets the data direction and CS once,
+*                  so that each pixel pushed afterwards only toggles the latch
+*                  and WR
+* Input          : None
+* Output         : None
+* Return         : None
+* Attention		 : the window and the cursor must already be set
+*******************************************************************************/
+static void LCD_StartWrite(void)
+{
+	LCD_WriteIndex(0x0022);
+
+	LPC_GPIO2->FIODIR |= 0xFF;          /* P2.0...P2.7 Output */
+	LCD_GPIO_COUNT(1);
+	LCD_DIR(1)		   				    				/* Interface A->B */
+	LCD_EN(0)	                        	/* Enable 2A->2B */
+	LCD_RD(1)
+	LCD_RS(1)
+	LCD_CS(0)
+}
+
+/*******************************************************************************
+* Function Name  : LCD_BeginWrite
+* Description    : Opens a GRAM write session on a rectangle: the window, the
+*                  data direction and CS are set once, so that each pixel pushed
+*                  afterwards only toggles the latch and WR
+* Input          : - Xpos: left column
+*                  - Ypos: top row
+*                  - Width: rectangle width, in pixels
+*                  - Height: rectangle height, in pixels
+* Output         : None
+* Return         : number of pixels in the (clipped) window, 0 if off screen
+* Attention		 : no other LCD function may be called before LCD_EndWrite
+*******************************************************************************/
+uint32_t LCD_BeginWrite(uint16_t Xpos, uint16_t Ypos, uint16_t Width, uint16_t Height)
+{
+	if( Xpos >= MAX_X || Ypos >= MAX_Y || Width == 0 || Height == 0 )
 	{
-		LCD_WriteReg(0x02,0x00);                                                  
-		LCD_WriteReg(0x03,0x00);  
-		                
-		LCD_WriteReg(0x04,0x00);                           
-		LCD_WriteReg(0x05,0xEF);  
-		                 
-		LCD_WriteReg(0x06,0x00);                           
-		LCD_WriteReg(0x07,0x00);    
-		               
-		LCD_WriteReg(0x08,0x01);                           
-		LCD_WriteReg(0x09,0x3F);     
+		return 0;
+	}
+	if( Width > MAX_X - Xpos )
+	{
+		Width = MAX_X - Xpos;
+	}
+	if( Height > MAX_Y - Ypos )
+	{
+		Height = MAX_Y - Ypos;
 	}
-	else
-	{	
-		LCD_SetCursor(0,0); 
-	}	
 
-	LCD_WriteIndex(0x0022);
-	for( index = 0; index < MAX_X * MAX_Y; index++ )
+	LCD_SetWindow(Xpos, Ypos, Width, Height);
+	LCD_StartWrite();
+
+	return (uint32_t)Width * Height;
+}
+
+/*******************************************************************************
+* Function Name  : LCD_PushPixels
+* Description    : Streams a run of pixels inside the session window
+* Input          : - pixels: RGB565 pixels, in auto-increment order
+*                  - count: number of pixels
+* Output         : None
+* Return         : None
+* Attention		 : to be called between LCD_BeginWrite and LCD_EndWrite
+*******************************************************************************/
+void LCD_PushPixels(const uint16_t *pixels, uint32_t count)
+{
+	uint16_t data;
+
+	while( count-- )
 	{
-		LCD_WriteData(Color);
+		data = *pixels++;
+		LPC_GPIO2->FIOPIN =  data;          /* Write D0..D7 */
+		LCD_LE(1)
+		LCD_LE(0)														/* latch D0..D7	*/
+		LPC_GPIO2->FIOPIN =  data >> 8;     /* Write D8..D15 */
+		LCD_GPIO_COUNT(2);
+		LCD_WR(0)
+		wait_delay(1);
+		LCD_WR(1)
+		LCD_BUS(LCDEmu_WriteData(data));
+	}
+}
+
+/*******************************************************************************
+* Function Name  : LCD_PushColor
+* Description    : Streams the same pixel count times inside the session window
+* Input          : - Color: RGB565 pixel
+*                  - count: number of pixels
+* Output         : None
+* Return         : None
+* Attention		 : the low byte stays in the latch and the high byte on P2,
+*                  so only WR is toggled for each pixel
+*******************************************************************************/
+void LCD_PushColor(uint16_t Color, uint32_t count)
+{
+	if( count == 0 )
+	{
+		return;
+	}
+	LPC_GPIO2->FIOPIN =  Color;         /* Write D0..D7 */
+	LCD_LE(1)
+	LCD_LE(0)														/* latch D0..D7	*/
+	LPC_GPIO2->FIOPIN =  Color >> 8;    /* Write D8..D15 */
+	LCD_GPIO_COUNT(2);
+	while( count-- )
+	{
+		LCD_WR(0)
+		wait_delay(1);
+		LCD_WR(1)
+		LCD_BUS(LCDEmu_WriteData(Color));
+	}
+}
+
+/*******************************************************************************
+* Function Name  : LCD_EndWrite
+* Description    : Closes a GRAM write session releasing CS
+* Input          : None
+* Output         : None
+* Return         : None
+* Attention		 : None
+*******************************************************************************/
+void LCD_EndWrite(void)
+{
+	LCD_CS(1)
+}
+
+/*******************************************************************************
+* Function Name  : LCD_FillRect
+* Description    : Fills a rectangle with a color, programming the GRAM window
+*                  once and streaming the pixels with auto-increment
+* Input          : - Xpos: left column
+*                  - Ypos: top row
+*                  - Width: rectangle width, in pixels
+*                  - Height: rectangle height, in pixels
+*                  - Color: fill color
+* Output         : None
+* Return         : None
+* Attention		 : the rectangle is clipped to the screen
+*******************************************************************************/
+void LCD_FillRect(uint16_t Xpos, uint16_t Ypos, uint16_t Width, uint16_t Height, uint16_t Color)
+{
+	uint32_t count;
+
+	count = LCD_BeginWrite(Xpos, Ypos, Width, Height);
+	if( count != 0 )
+	{
+		LCD_PushColor(Color, count);
+		LCD_EndWrite();
 	}
 }
 
@@ -449,6 +788,7 @@ uint16_t LCD_GetPoint(uint16_t Xpos,uint16_t Ypos)
 {
 	uint16_t dummy;
 	
+	LCD_ResetWindow();
 	LCD_SetCursor(Xpos,Ypos);
 	LCD_WriteIndex(0x0022);  
 	
@@ -498,6 +838,7 @@ void LCD_SetPoint(uint16_t Xpos,uint16_t Ypos,uint16_t point)
 	{
 		return;
 	}
+	LCD_ResetWindow();
 	LCD_SetCursor(Xpos,Ypos);
 	LCD_WriteReg(0x0022,point);
 }
@@ -537,22 +878,12 @@ void LCD_DrawLine( uint16_t x0, uint16_t y0, uint16_t x1, uint16_t y1 , uint16_t
 
     if( dx == 0 )     /* Xû ֱ */ 
     {
-        do
-        { 
-            LCD_SetPoint(x0, y0, color);   /* ʾ 费ֱ */
-            y0++;
-        }
-        while( y1 >= y0 ); 
+        LCD_FillRect(x0, y0, 1, dy + 1, color);   /* vertical line: one windowed burst */
 		return; 
     }
     if( dy == 0 )     /* Yû ˮƽֱ */ 
     {
-        do
-        {
-            LCD_SetPoint(x0, y0, color);   /* ʾ ˮƽ */
-            x0++;
-        }
-        while( x1 >= x0 ); 
+        LCD_FillRect(x0, y0, dx + 1, 1, color);   /* horizontal line: one windowed burst */
 		return;
     }
 	/* ɭķ(Bresenham)㷨 */
@@ -596,6 +927,134 @@ void LCD_DrawLine( uint16_t x0, uint16_t y0, uint16_t x1, uint16_t y1 , uint16_t
 	}
 } 
 
+/* 
+ * Glyph rotations, in steps of 90 degrees clockwise: direction of the pixels
+ * of a glyph row on the screen (the rows advance in the direction of the next
+ * step), position of the first pixel and size of the character
+ */
+static const int8_t GlyphStep[4][2] = { {1, 0}, {0, 1}, {-1, 0}, {0, -1} };
+static const uint8_t GlyphOrigin[4][2] = { {0, 0}, {15, 0}, {7, 15}, {0, 7} };
+static const uint8_t GlyphSize[4][2] = { {8, 16}, {16, 8}, {8, 16}, {16, 8} };
+
+/*******************************************************************************
+* Function Name  : LCD_CanRotate
+* Description    : Tells if the controller rotates the writes with R03
+* Input          : None
+* Output         : None
+* Return         : 1 for the ILI932x compatible controllers
+* Attention		 : None
+*******************************************************************************/
+static uint8_t LCD_CanRotate(void)
+{
+	switch( LCD_Code )
+	{
+		case SSD1298:
+		case SSD1289:
+		case HX8346A:
+		case HX8347A:
+		case HX8347D:
+		case SSD2119:
+			return 0;
+		default:
+			return 1;
+	}
+}
+
+/*******************************************************************************
+* Function Name  : LCD_SetEntryMode
+* Description    : Programs the address counter so that a glyph streamed row
+*                  by row lands rotated on the screen
+* Input          : - rot: rotation, in steps of 90 degrees clockwise
+* Output         : None
+* Return         : None
+* Attention		 : rot 0 restores the default entry mode. Like the other
+*                  burst functions, it assumes DISP_ORIENTATION 0
+*******************************************************************************/
+static void LCD_SetEntryMode(uint8_t rot)
+{
+	int8_t ix, iy, ox, oy;
+	uint16_t mode = ENTRY_BGR;
+
+	ix = GlyphStep[rot][0];
+	iy = GlyphStep[rot][1];
+	ox = GlyphStep[(rot + 1) & 3][0];
+	oy = GlyphStep[(rot + 1) & 3][1];
+
+	if( ix == 0 )
+	{
+		mode |= ENTRY_AM;
+	}
+	if( ix + ox > 0 )
+	{
+		mode |= ENTRY_ID0;
+	}
+	if( iy + oy > 0 )
+	{
+		mode |= ENTRY_ID1;
+	}
+	LCD_WriteReg(0x0003, mode);
+}
+
+/*******************************************************************************
+* Function Name  : LCD_PutGlyph
+* Description    : Draws a character opening a single GRAM window and streaming
+*                  its 128 pixels row by row, as they are stored in the font:
+*                  the entry mode set by the caller does the rotation
+* Input          : - Xpos, Ypos: top-left corner of the rotated character
+*				   - ASCI: character
+*				   - charColor, bkColor: foreground and background colors
+*				   - rot: rotation, in steps of 90 degrees clockwise
+* Output         : None
+* Return         : None
+* Attention		 : a character partially off the screen, or a controller that
+*                  cannot rotate, falls back to LCD_SetPoint
+*******************************************************************************/
+static void LCD_PutGlyph( uint16_t Xpos, uint16_t Ypos, uint8_t ASCI, uint16_t charColor, uint16_t bkColor, uint8_t rot )
+{
+	const uint8_t *glyph;
+	uint16_t line[8];
+	uint16_t i, j;
+	uint16_t x, y;
+	uint8_t burst;
+
+	glyph = GetASCIIGlyph(ASCI);
+	burst = ( Xpos + GlyphSize[rot][0] <= MAX_X && Ypos + GlyphSize[rot][1] <= MAX_Y ) &&
+	        ( rot == 0 || LCD_CanRotate() );
+	if( burst )
+	{
+		LCD_SetWindow(Xpos, Ypos, GlyphSize[rot][0], GlyphSize[rot][1]);
+		if( rot != 0 )
+		{
+			LCD_SetCursor(Xpos + GlyphOrigin[rot][0], Ypos + GlyphOrigin[rot][1]);
+		}
+		LCD_StartWrite();
+	}
+	for( i=0; i<16; i++ )
+	{
+		for( j=0; j<8; j++ )
+		{
+			line[j] = ( (glyph[i] >> (7 - j)) & 0x01 ) ? charColor : bkColor;
+		}
+		if( burst )
+		{
+			LCD_PushPixels(line, 8);
+		}
+		else
+		{
+			for( j=0; j<8; j++ )
+			{
+				x = Xpos + GlyphOrigin[rot][0] + j * GlyphStep[rot][0] + i * GlyphStep[(rot + 1) & 3][0];
+				y = Ypos + GlyphOrigin[rot][1] + j * GlyphStep[rot][1] + i * GlyphStep[(rot + 1) & 3][1];
+				LCD_SetPoint( x, y, line[j] );
+			}
+		}
+	}
+	if( burst )
+	{
+		LCD_EndWrite();
+	}
+}
+
 /******************************************************************************
 * Function Name  : PutChar
 * Description    : Lcdλʾһַ
@@ -610,24 +1069,87 @@ void LCD_DrawLine( uint16_t x0, uint16_t y0, uint16_t x1, uint16_t y1 , uint16_t
 *******************************************************************************/
 void PutChar( uint16_t Xpos, uint16_t Ypos, uint8_t ASCI, uint16_t charColor, uint16_t bkColor )
 {
-	uint16_t i, j;
-    uint8_t buffer[16], tmp_char;
-    GetASCIICode(buffer,ASCI);  /* ȡģ */
-    for( i=0; i<16; i++ )
-    {
-        tmp_char = buffer[i];
-        for( j=0; j<8; j++ )
-        {
-            if( ((tmp_char >> (7 - j)) & 0x01) == 0x01 )
-            {
-                LCD_SetPoint( Xpos + j, Ypos + i, charColor );  /* ַɫ */
-            }
-            else
-            {
-                LCD_SetPoint( Xpos + j, Ypos + i, bkColor );  /* ɫ */
-            }
-        }
-    }
+	LCD_PutGlyph( Xpos, Ypos, ASCI, charColor, bkColor, 0 );
+}
+
+/******************************************************************************
+* Function Name  : PutCharRotated
+* Description    : Draws a character rotated clockwise, letting the controller
+*                  do the rotation: it costs the same as PutChar
+* Input          : - Xpos, Ypos: top-left corner of the rotated character,
+*                    that is 16x8 pixels for 90 and 270 degrees
+*				   - ASCI: character
+*				   - charColor, bkColor: foreground and background colors
+*				   - angle: 0, 90, 180 or 270
+* Output         : None
+* Return         : None
+* Attention		 : None
+*******************************************************************************/
+void PutCharRotated( uint16_t Xpos, uint16_t Ypos, uint8_t ASCI, uint16_t charColor, uint16_t bkColor, uint16_t angle )
+{
+	uint8_t rot = ( angle / 90 ) & 3;
+	uint8_t hw = ( rot != 0 && LCD_CanRotate() );
+
+	if( hw )
+	{
+		LCD_SetEntryMode(rot);
+	}
+	LCD_PutGlyph( Xpos, Ypos, ASCI, charColor, bkColor, rot );
+	if( hw )
+	{
+		LCD_SetEntryMode(0);
+	}
+}
+
+/******************************************************************************
+* Function Name  : GUI_TextRotated
+* Description    : Draws a string rotated clockwise, programming the entry mode
+*                  once for the whole string
+* Input          : - Xpos, Ypos: top-left corner of the rotated string
+*				   - str: string
+*				   - Color, bkColor: foreground and background colors
+*				   - angle: 0, 90, 180 or 270
+* Output         : None
+* Return         : None
+* Attention		 : the string does not wrap, at 180 degrees it reads from the
+*                  opposite side of the board, so its first character is the
+*                  rightmost one
+*******************************************************************************/
+void GUI_TextRotated(uint16_t Xpos, uint16_t Ypos, uint8_t *str, uint16_t Color, uint16_t bkColor, uint16_t angle)
+{
+	uint8_t rot = ( angle / 90 ) & 3;
+	uint8_t hw = ( rot != 0 && LCD_CanRotate() );
+	uint16_t len, i;
+
+	for( len = 0; str[len] != 0; len++ )
+	{
+	}
+	if( hw )
+	{
+		LCD_SetEntryMode(rot);
+	}
+	for( i = 0; i < len; i++ )
+	{
+		switch( rot )
+		{
+			case 0:
+				LCD_PutGlyph( Xpos + 8 * i, Ypos, str[i], Color, bkColor, rot );
+				break;
+			case 1:
+				LCD_PutGlyph( Xpos, Ypos + 8 * i, str[i], Color, bkColor, rot );
+				break;
+			case 2:
+				LCD_PutGlyph( Xpos + 8 * (len - 1 - i), Ypos, str[i], Color, bkColor, rot );
+				break;
+			default:
+				LCD_PutGlyph( Xpos, Ypos + 8 * (len - 1 - i), str[i], Color, bkColor, rot );
+				break;
+		}
+	}
+	if( hw )
+	{
+		LCD_SetEntryMode(0);
+	}
 }
 
 /******************************************************************************
@@ -0,0 +1,156 @@
+/*********************************************************************************************************
+**--------------File Info---------------------------------------------------------------------------------
+** File name:           GLCD_band.c
+** Last modified Date:  2026-10-17
+** Last Version:        V1.00
+** Descriptions:        Banded renderer. A full 240x320 frame buffer does not fit in the SRAM, so the
+**                      screen is split in bands of BAND_ROWS lines: only the dirty part of a dirty band
+**                      is composed in the band buffer and then written with a single windowed burst,
+**                      so the panel never shows a half drawn frame. Clean bands are skipped and
+**                      everything drawn with GUI_Text/LCD_DrawLine outside of them is left untouched.
+** Correlated files:    GLCD_band.h, GLCD.c
+**--------------------------------------------------------------------------------------------------------
+*********************************************************************************************************/
+#include "GLCD_band.h"
+
+#if defined(__CC_ARM) && !defined(GLCD_EMULATOR)
+/* AHB SRAM bank 0, not used by the rest of the project */
+#define BAND_RAM	__attribute__((at(0x2007C000)))
+#else
+#define BAND_RAM
+#endif
+
+/* Band buffer, packed with the width of the area being composed */
+static uint16_t band_buffer[BAND_ROWS * MAX_X] BAND_RAM;
+
+/* Dirty area of each band, [x0, x1) x [y0, y1), clean when x1 is 0 */
+static uint16_t band_x0[BAND_COUNT], band_x1[BAND_COUNT];
+static uint16_t band_y0[BAND_COUNT], band_y1[BAND_COUNT];
+
+/* Area being composed */
+static uint16_t area_x, area_y, area_w, area_h;
+
+/*******************************************************************************
+* Function Name  : Band_Invalidate
+* Description    : Mark an area to be composed by the next Band_Render
+* Input          : - Xpos, Ypos: top-left corner
+*                  - Width, Height: size of the area
+* Output         : None
+* Return         : None
+* Attention		 : Every band touched is redrawn across the bounding box of
+*                  all the areas marked in it
+*******************************************************************************/
+void Band_Invalidate(uint16_t Xpos, uint16_t Ypos, uint16_t Width, uint16_t Height)
+{
+	uint16_t x1, y1, band, top, bottom;
+
+	if( Xpos >= MAX_X || Ypos >= MAX_Y || Width == 0 || Height == 0 )
+	{
+		return;
+	}
+	x1 = ( Xpos + Width > MAX_X ) ? MAX_X : Xpos + Width;
+	y1 = ( Ypos + Height > MAX_Y ) ? MAX_Y : Ypos + Height;
+
+	for( band = Ypos / BAND_ROWS; band * BAND_ROWS < y1; band++ )
+	{
+		top = ( Ypos > band * BAND_ROWS ) ? Ypos : band * BAND_ROWS;
+		bottom = ( y1 < (band + 1) * BAND_ROWS ) ? y1 : (band + 1) * BAND_ROWS;
+		if( band_x1[band] == 0 )
+		{
+			band_x0[band] = Xpos;
+			band_x1[band] = x1;
+			band_y0[band] = top;
+			band_y1[band] = bottom;
+		}
+		else
+		{
+			if( Xpos < band_x0[band] )
+			{
+				band_x0[band] = Xpos;
+			}
+			if( x1 > band_x1[band] )
+			{
+				band_x1[band] = x1;
+			}
+			if( top < band_y0[band] )
+			{
+				band_y0[band] = top;
+			}
+			if( bottom > band_y1[band] )
+			{
+				band_y1[band] = bottom;
+			}
+		}
+	}
+}
+
+/*******************************************************************************
+* Function Name  : Band_Render
+* Description    : Compose and write every dirty band
+* Input          : - paint: called for every dirty area, it must cover all of it
+* Output         : None
+* Return         : Pixels written to the LCD
+* Attention		 : None
+*******************************************************************************/
+uint32_t Band_Render(BandPainter paint)
+{
+	uint32_t pixels = 0, count;
+	uint16_t band;
+
+	for( band = 0; band < BAND_COUNT; band++ )
+	{
+		if( band_x1[band] == 0 )
+		{
+			continue;
+		}
+		area_x = band_x0[band];
+		area_w = band_x1[band] - band_x0[band];
+		area_y = band_y0[band];
+		area_h = band_y1[band] - band_y0[band];
+		band_x1[band] = 0;
+
+		paint(area_x, area_y, area_w, area_h);
+
+		count = LCD_BeginWrite(area_x, area_y, area_w, area_h);
+		LCD_PushPixels(band_buffer, count);
+		LCD_EndWrite();
+		pixels += count;
+	}
+	area_w = 0;
+	return pixels;
+}
+
+/*******************************************************************************
+* Function Name  : Band_FillRect
+* Description    : Fill a rectangle in the band being composed
+* Input          : - Xpos, Ypos: top-left corner, in screen coordinates
+*                  - Width, Height: size of the rectangle
+*                  - Color: RGB565 fill color
+* Output         : None
+* Return         : None
+* Attention		 : Clipped to the area being composed, only valid inside a
+*                  BandPainter
+*******************************************************************************/
+void Band_FillRect(uint16_t Xpos, uint16_t Ypos, uint16_t Width, uint16_t Height, uint16_t Color)
+{
+	uint16_t x0, y0, x1, y1, x, y;
+	uint16_t *pixel;
+
+	x0 = ( Xpos > area_x ) ? Xpos : area_x;
+	y0 = ( Ypos > area_y ) ? Ypos : area_y;
+	x1 = ( Xpos + Width < area_x + area_w ) ? Xpos + Width : area_x + area_w;
+	y1 = ( Ypos + Height < area_y + area_h ) ? Ypos + Height : area_y + area_h;
+
+	for( y = y0; y < y1; y++ )
+	{
+		pixel = &band_buffer[(y - area_y) * area_w + (x0 - area_x)];
+		for( x = x0; x < x1; x++ )
+		{
+			*pixel++ = Color;
+		}
+	}
+}
+
+/*********************************************************************************************************
+      END FILE
+*********************************************************************************************************/
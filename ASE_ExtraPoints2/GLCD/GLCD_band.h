@@ -0,0 +1,33 @@
+/*********************************************************************************************************
+**--------------File Info---------------------------------------------------------------------------------
+** File name:           GLCD_band.h
+** Last modified Date:  2026-10-17
+** Last Version:        V1.00
+** Descriptions:        Prototypes of the banded renderer: the screen is composed a few rows at a time
+**                      in a small buffer, then each band is sent to the LCD with one burst
+** Correlated files:    GLCD_band.c, GLCD.c
+**--------------------------------------------------------------------------------------------------------
+*********************************************************************************************************/
+#ifndef __GLCD_BAND_H
+#define __GLCD_BAND_H
+
+#include "GLCD.h"
+
+/* Rows of a band, the buffer holds BAND_ROWS full screen lines */
+#define BAND_ROWS		16
+#define BAND_COUNT	((MAX_Y + BAND_ROWS - 1) / BAND_ROWS)
+
+/* 
+ * Called once for every dirty band, it must paint the whole area
+ */
+typedef void (*BandPainter)(uint16_t Xpos, uint16_t Ypos, uint16_t Width, uint16_t Height);
+
+void Band_Invalidate(uint16_t Xpos, uint16_t Ypos, uint16_t Width, uint16_t Height);
+uint32_t Band_Render(BandPainter paint);
+void Band_FillRect(uint16_t Xpos, uint16_t Ypos, uint16_t Width, uint16_t Height, uint16_t Color);
+
+#endif
+
+/*********************************************************************************************************
+      END FILE
+*********************************************************************************************************/
@@ -0,0 +1,73 @@
+/*********************************************************************************************************
+**--------------File Info---------------------------------------------------------------------------------
+** File name:           GLCD_emu.h
+** Last modified Date:  2026-10-17
+** Last Version:        V1.00
+** Descriptions:        Prototypes of the host-side ILI9325 model used by the GLCD_EMULATOR build
+** Correlated files:    GLCD_emu.c, GLCD.c
+**--------------------------------------------------------------------------------------------------------
+*********************************************************************************************************/
+#ifndef __GLCD_EMU_H
+#define __GLCD_EMU_H
+
+#include <stdio.h>
+#include <stdint.h>
+
+/* Physical size of the GRAM, independent of DISP_ORIENTATION */
+#define EMU_GRAM_X		240
+#define EMU_GRAM_Y		320
+
+/* Maximum number of primitives tracked by LCDEmu_Begin/LCDEmu_End */
+#define EMU_MAX_PRIMITIVES	16
+
+/* Bus cycle counters */
+typedef struct {
+	uint32_t index_writes;		/* writes with RS low (register index) */
+	uint32_t data_writes;			/* writes with RS high (register value or pixel) */
+	uint32_t data_reads;			/* reads with RS high */
+	uint32_t pixels;					/* GRAM writes through 0x22 */
+} LCDEmu_Stats;
+
+/* Per primitive statistics */
+typedef struct {
+	const char *name;
+	uint32_t calls;
+	LCDEmu_Stats bus;
+} LCDEmu_Primitive;
+
+/* Stand-ins of the GPIO registers GLCD.c drives the bus with: the stores land here */
+typedef struct {
+	volatile uint32_t FIODIR;
+	volatile uint32_t FIOPIN;
+	volatile uint32_t FIOSET;
+	volatile uint32_t FIOCLR;
+	volatile uint8_t FIOPIN0;
+} LCDEmu_Gpio;
+
+extern LCDEmu_Gpio LCDEmu_Gpio0, LCDEmu_Gpio2;
+
+#define LPC_GPIO0			(&LCDEmu_Gpio0)
+#define LPC_GPIO2			(&LCDEmu_Gpio2)
+
+/* Bus interface, called by GLCD.c when WR or RD completes a bus cycle */
+void LCDEmu_Init(void);
+void LCDEmu_WriteIndex(uint16_t index);
+void LCDEmu_WriteData(uint16_t data);
+uint16_t LCDEmu_ReadData(void);
+
+/* Inspection */
+uint16_t LCDEmu_GetPixel(uint16_t Xpos, uint16_t Ypos);
+uint16_t LCDEmu_GetReg(uint8_t reg);
+int LCDEmu_DumpPPM(const char *path);
+
+/* Statistics */
+void LCDEmu_GetStats(LCDEmu_Stats *stats);
+void LCDEmu_ResetStats(void);
+void LCDEmu_Begin(const char *primitive);
+void LCDEmu_End(void);
+void LCDEmu_PrintStats(FILE *out);
+
+#endif /* end __GLCD_EMU_H */
+/*****************************************************************************
+**                            End Of File
+******************************************************************************/
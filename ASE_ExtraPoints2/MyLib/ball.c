@@ -0,0 +1,363 @@
+#include "ball.h"
+
+/* sin and cos of k * 7.5 degrees, k = 0 .. BALL_ANGLES */
+static const fix16_t Sin[BALL_ANGLES + 1] = {0, 8554, 16962, 25080, 32768, 39896, 46341, 51993, 56756};
+static const fix16_t Cos[BALL_ANGLES + 1] = {65536, 64975, 63303, 60547, 56756, 51993, 46341, 39896, 32768};
+
+/********************************************************************************
+*                                                                               *
+* FUNCTION NAME: Ball_Init				                                              *
+*                                                                               *
+* PURPOSE: Place a ball at speed 1																							*
+* ARGUMENT LIST:                                                                *
+*                                                                               *
+* Argument  Type         IO     Description                                     *
+* --------- --------     --     ---------------------------------               *
+* ball			Ball*				 O			Ball to initialize															*
+*	x, y			int16_t			 I			Top-left corner, in px													*
+*	size			uint16_t		 I			Side, in px																			*
+*	vx, vy		fix16_t			 I			Velocity, in px per step												*
+*																																								*
+* RETURN VALUE: void                                                            *
+*                                                                               *
+********************************************************************************/
+void Ball_Init(Ball *ball, int16_t x, int16_t y, uint16_t size, fix16_t vx, fix16_t vy)
+{
+	ball->x = FIX(x);
+	ball->y = FIX(y);
+	ball->vx = vx;
+	ball->vy = vy;
+	ball->speed = FIX_ONE;
+	ball->size = size;
+}
+
+/********************************************************************************
+*                                                                               *
+* FUNCTION NAME: Ball_Move				                                              *
+*                                                                               *
+* PURPOSE: Move the ball by one step at its speed among still obstacles. The		*
+*					 path is swept, so the ball never goes through an obstacle however		*
+*					 fast: at each contact it stops on the face hit, bounce() gives it		*
+*					 the new velocity and it goes on for the rest of the step							*
+* ARGUMENT LIST:                                                                *
+*                                                                               *
+* Argument  Type         IO     Description                                     *
+* --------- --------     --     ---------------------------------               *
+* ball			Ball*				 I/O		Ball to move																		*
+* obstacles	Box*				 I			Obstacles, in px																*
+* count			int					 I			Number of obstacles															*
+* bounce		function		 I			Called with the index of the obstacle hit				*
+*																																								*
+* RETURN VALUE: void                                                            *
+*                                                                               *
+********************************************************************************/
+void Ball_Move(Ball *ball, const Box *obstacles, int count, void (*bounce)(Ball *ball, int index, const Hit *hit))
+{
+	fix16_t rest = FIX_ONE, dx, dy;
+	Box box;
+	Hit hit;
+	int i, n;
+
+	box.w = FIX(ball->size);
+	box.h = FIX(ball->size);
+	for(n = 0; n < BALL_MAX_HITS && rest > 0; n++)
+	{
+		dx = FIX_MUL(FIX_MUL(ball->vx, ball->speed), rest);
+		dy = FIX_MUL(FIX_MUL(ball->vy, ball->speed), rest);
+		box.x = ball->x;
+		box.y = ball->y;
+		i = Collide_First(&box, dx, dy, obstacles, count, &hit);
+		if(i < 0)
+		{
+			ball->x += dx;
+			ball->y += dy;
+			return;
+		}
+
+		ball->x += FIX_MUL(dx, hit.t);
+		ball->y += FIX_MUL(dy, hit.t);
+		/* Exactly on the face, the rounding must not leave the ball inside */
+		if(hit.nx != 0)
+		{
+			ball->x = hit.nx < 0 ? obstacles[i].x - box.w : obstacles[i].x + obstacles[i].w;
+		}
+		if(hit.ny != 0)
+		{
+			ball->y = hit.ny < 0 ? obstacles[i].y - box.h : obstacles[i].y + obstacles[i].h;
+		}
+		bounce(ball, i, &hit);
+		rest = FIX_MUL(rest, FIX_ONE - hit.t);
+	}
+}
+
+/********************************************************************************
+*                                                                               *
+* FUNCTION NAME: Ball_Reflect			                                              *
+*                                                                               *
+* PURPOSE: Plain bounce: the velocity is reversed along the normal of the hit	*
+* ARGUMENT LIST:                                                                *
+*                                                                               *
+* Argument  Type         IO     Description                                     *
+* --------- --------     --     ---------------------------------               *
+* ball			Ball*				 I/O		Ball that hit something													*
+* hit				Hit*				 I			Contact																					*
+*																																								*
+* RETURN VALUE: void                                                            *
+*                                                                               *
+********************************************************************************/
+void Ball_Reflect(Ball *ball, const Hit *hit)
+{
+	if(hit->nx != 0)
+	{
+		ball->vx = -ball->vx;
+	}
+	if(hit->ny != 0)
+	{
+		ball->vy = -ball->vy;
+	}
+}
+
+/********************************************************************************
+*                                                                               *
+* FUNCTION NAME: Ball_Deflect			                                              *
+*                                                                               *
+* PURPOSE: Send the ball back from a paddle: the farther from the center it		*
+*					 hits, the wider the angle, up to 60 degrees from the vertical.				*
+*					 A moving paddle adds one more step of angle in its direction					*
+* ARGUMENT LIST:                                                                *
+*                                                                               *
+* Argument  Type         IO     Description                                     *
+* --------- --------     --     ---------------------------------               *
+* ball			Ball*				 I/O		Ball to deflect																	*
+*	offset		int16_t			 I			Ball center minus paddle center, in px					*
+*	half			int16_t			 I			Offset of a hit on the paddle corner						*
+*	spin			int16_t			 I			-1, 0 or 1 as the paddle moves left, not, right	*
+*	dir				int16_t			 I			-1 to send the ball up, 1 down									*
+*																																								*
+* RETURN VALUE: void                                                            *
+*                                                                               *
+********************************************************************************/
+void Ball_Deflect(Ball *ball, int16_t offset, int16_t half, int16_t spin, int16_t dir)
+{
+	int32_t k = (int32_t)offset * BALL_ANGLES / half + spin;
+
+	/* A straight vertical bounce would repeat forever against a still paddle */
+	if(k == 0)
+	{
+		k = ball->vx < 0 ? -1 : 1;
+	}
+	if(k > BALL_ANGLES)
+	{
+		k = BALL_ANGLES;
+	}
+	else if(k < -BALL_ANGLES)
+	{
+		k = -BALL_ANGLES;
+	}
+
+	ball->vx = k < 0 ? -FIX_MUL(BALL_SPEED, Sin[-k]) : FIX_MUL(BALL_SPEED, Sin[k]);
+	ball->vy = dir * FIX_MUL(BALL_SPEED, Cos[k < 0 ? -k : k]);
+}
+
+/********************************************************************************
+*                                                                               *
+* FUNCTION NAME: Ball_SpeedUp			                                              *
+*                                                                               *
+* PURPOSE: Raise the speed of the ball, up to BALL_MAX_SPEED										*
+* ARGUMENT LIST:                                                                *
+*                                                                               *
+* Argument  Type         IO     Description                                     *
+* --------- --------     --     ---------------------------------               *
+* ball			Ball*				 I/O		Ball to speed up																*
+*																																								*
+* RETURN VALUE: void                                                            *
+*                                                                               *
+********************************************************************************/
+void Ball_SpeedUp(Ball *ball)
+{
+	ball->speed += BALL_SPEEDUP;
+	if(ball->speed > BALL_MAX_SPEED)
+	{
+		ball->speed = BALL_MAX_SPEED;
+	}
+}
+
+/********************************************************************************
+*                                                                               *
+* FUNCTION NAME: Pool_Init				                                              *
+*                                                                               *
+* PURPOSE: Empty a pool																													*
+* ARGUMENT LIST:                                                                *
+*                                                                               *
+* Argument  Type         IO     Description                                     *
+* --------- --------     --     ---------------------------------               *
+* pool			BallPool*		 O			Pool to empty																		*
+*	size			uint16_t		 I			Side of the balls, in px												*
+*																																								*
+* RETURN VALUE: void                                                            *
+*                                                                               *
+********************************************************************************/
+void Pool_Init(BallPool *pool, uint16_t size)
+{
+	pool->count = 0;
+	pool->size = size;
+}
+
+/********************************************************************************
+*                                                                               *
+* FUNCTION NAME: Pool_Add					                                              *
+*                                                                               *
+* PURPOSE: Put a ball in play, after the others																	*
+* ARGUMENT LIST:                                                                *
+*                                                                               *
+* Argument  Type         IO     Description                                     *
+* --------- --------     --     ---------------------------------               *
+* pool			BallPool*		 I/O		Pool																						*
+*	ball			Ball*				 I			Ball to add, of the size of the pool						*
+*																																								*
+* RETURN VALUE: int, index of the ball, -1 if the pool is full                  *
+*                                                                               *
+********************************************************************************/
+int Pool_Add(BallPool *pool, const Ball *ball)
+{
+	if(pool->count == BALL_POOL)
+	{
+		return -1;
+	}
+	Pool_Set(pool, pool->count, ball);
+	return pool->count++;
+}
+
+/********************************************************************************
+*                                                                               *
+* FUNCTION NAME: Pool_Get					                                              *
+*                                                                               *
+* PURPOSE: Copy a ball out of the pool																					*
+* ARGUMENT LIST:                                                                *
+*                                                                               *
+* Argument  Type         IO     Description                                     *
+* --------- --------     --     ---------------------------------               *
+* pool			BallPool*		 I			Pool																						*
+*	i					int					 I			Index of the ball																*
+*	ball			Ball*				 O			Copy																						*
+*																																								*
+* RETURN VALUE: void                                                            *
+*                                                                               *
+********************************************************************************/
+void Pool_Get(const BallPool *pool, int i, Ball *ball)
+{
+	ball->x = pool->x[i];
+	ball->y = pool->y[i];
+	ball->vx = pool->vx[i];
+	ball->vy = pool->vy[i];
+	ball->speed = pool->speed[i];
+	ball->size = pool->size;
+}
+
+/********************************************************************************
+*                                                                               *
+* FUNCTION NAME: Pool_Set					                                              *
+*                                                                               *
+* PURPOSE: Copy a ball into the pool																						*
+* ARGUMENT LIST:                                                                *
+*                                                                               *
+* Argument  Type         IO     Description                                     *
+* --------- --------     --     ---------------------------------               *
+* pool			BallPool*		 I/O		Pool																						*
+*	i					int					 I			Index of the ball																*
+*	ball			Ball*				 I			Ball																						*
+*																																								*
+* RETURN VALUE: void                                                            *
+*                                                                               *
+********************************************************************************/
+void Pool_Set(BallPool *pool, int i, const Ball *ball)
+{
+	pool->x[i] = ball->x;
+	pool->y[i] = ball->y;
+	pool->vx[i] = ball->vx;
+	pool->vy[i] = ball->vy;
+	pool->speed[i] = ball->speed;
+}
+
+/********************************************************************************
+*                                                                               *
+* FUNCTION NAME: Pool_Remove			                                              *
+*                                                                               *
+* PURPOSE: Take a ball out of play: the last ball takes its index								*
+* ARGUMENT LIST:                                                                *
+*                                                                               *
+* Argument  Type         IO     Description                                     *
+* --------- --------     --     ---------------------------------               *
+* pool			BallPool*		 I/O		Pool																						*
+*	i					int					 I			Index of the ball																*
+*																																								*
+* RETURN VALUE: void                                                            *
+*                                                                               *
+********************************************************************************/
+void Pool_Remove(BallPool *pool, int i)
+{
+	int last = --pool->count;
+
+	pool->x[i] = pool->x[last];
+	pool->y[i] = pool->y[last];
+	pool->vx[i] = pool->vx[last];
+	pool->vy[i] = pool->vy[last];
+	pool->speed[i] = pool->speed[last];
+}
+
+/********************************************************************************
+*                                                                               *
+* FUNCTION NAME: Pool_Move				                                              *
+*                                                                               *
+* PURPOSE: Move every ball of the pool by one step. A ball whose whole path			*
+*					 stays clear of the bounding boxes of the obstacles just moves, the		*
+*					 few near an obstacle are swept by Ball_Move													*
+* ARGUMENT LIST:                                                                *
+*                                                                               *
+* Argument  Type         IO     Description                                     *
+* --------- --------     --     ---------------------------------               *
+* pool			BallPool*		 I/O		Balls to move																		*
+* obstacles	Box*				 I			Obstacles, in px																*
+* count			int					 I			Number of obstacles															*
+* bounce		function		 I			Called with the index of the obstacle hit				*
+*																																								*
+* RETURN VALUE: void                                                            *
+*                                                                               *
+********************************************************************************/
+void Pool_Move(BallPool *pool, const Box *obstacles, int count, void (*bounce)(Ball *ball, int index, const Hit *hit))
+{
+	fix16_t dx, dy, x0, y0, x1, y1, size = FIX(pool->size);
+	Ball ball;
+	int i, k;
+
+	for(i = 0; i < pool->count; i++)
+	{
+		dx = FIX_MUL(pool->vx[i], pool->speed[i]);
+		dy = FIX_MUL(pool->vy[i], pool->speed[i]);
+
+		/* Box swept by the ball during the step */
+		x0 = dx < 0 ? pool->x[i] + dx : pool->x[i];
+		y0 = dy < 0 ? pool->y[i] + dy : pool->y[i];
+		x1 = (dx < 0 ? pool->x[i] : pool->x[i] + dx) + size;
+		y1 = (dy < 0 ? pool->y[i] : pool->y[i] + dy) + size;
+		for(k = 0; k < count; k++)
+		{
+			/* Touching counts: a ball on a face may still hit it */
+			if(x0 <= obstacles[k].x + obstacles[k].w && obstacles[k].x <= x1 &&
+				 y0 <= obstacles[k].y + obstacles[k].h && obstacles[k].y <= y1)
+			{
+				break;
+			}
+		}
+		if(k == count)
+		{
+			pool->x[i] += dx;
+			pool->y[i] += dy;
+			continue;
+		}
+
+		Pool_Get(pool, i, &ball);
+		Ball_Move(&ball, obstacles, count, bounce);
+		Pool_Set(pool, i, &ball);
+	}
+}
@@ -0,0 +1,152 @@
+#include "collide.h"
+
+/* Stands for an axis that never starts or stops overlapping */
+#define T_NEVER		INT32_MAX
+
+/********************************************************************************
+*                                                                               *
+* FUNCTION NAME: Ratio						                                              *
+*                                                                               *
+* PURPOSE: a / b, saturated: a tiny move over a long distance must not wrap		*
+* ARGUMENT LIST:                                                                *
+*                                                                               *
+* Argument  Type         IO     Description                                     *
+* --------- --------     --     ---------------------------------               *
+* a, b			fix16_t			 I			Distance and move, b not 0											*
+*																																								*
+* RETURN VALUE: the quotient, between -T_NEVER and T_NEVER                     *
+*                                                                               *
+********************************************************************************/
+static fix16_t Ratio(fix16_t a, fix16_t b)
+{
+	int64_t r = (int64_t)a * FIX_ONE / b;
+
+	if(r > T_NEVER)
+	{
+		return T_NEVER;
+	}
+	if(r < -T_NEVER)
+	{
+		return -T_NEVER;
+	}
+	return (fix16_t)r;
+}
+
+/********************************************************************************
+*                                                                               *
+* FUNCTION NAME: SweepAxis				                                              *
+*                                                                               *
+* PURPOSE: Times, as fractions of the move, at which a moving interval starts	*
+*					 and stops overlapping a still one																		*
+* ARGUMENT LIST:                                                                *
+*                                                                               *
+* Argument  Type         IO     Description                                     *
+* --------- --------     --     ---------------------------------               *
+* m, mw			fix16_t			 I			Moving interval [m, m + mw)											*
+* d					fix16_t			 I			Move of the interval														*
+* t, tw			fix16_t			 I			Still interval [t, t + tw)											*
+* entry			fix16_t*		 O			Start of the overlap														*
+* exit			fix16_t*		 O			End of the overlap															*
+*																																								*
+* RETURN VALUE: 0 if the intervals never overlap, 1 otherwise                   *
+*                                                                               *
+********************************************************************************/
+static int SweepAxis(fix16_t m, fix16_t mw, fix16_t d, fix16_t t, fix16_t tw, fix16_t *entry, fix16_t *exit)
+{
+	if(d > 0)
+	{
+		*entry = Ratio(t - (m + mw), d);
+		*exit = Ratio(t + tw - m, d);
+	}
+	else if(d < 0)
+	{
+		*entry = Ratio(t + tw - m, d);
+		*exit = Ratio(t - (m + mw), d);
+	}
+	else if(m < t + tw && m + mw > t)
+	{
+		/* Still on this axis and overlapping: only the other axis decides */
+		*entry = -T_NEVER;
+		*exit = T_NEVER;
+	}
+	else
+	{
+		return 0;
+	}
+	return 1;
+}
+
+/********************************************************************************
+*                                                                               *
+* FUNCTION NAME: Collide_Sweep		                                              *
+*                                                                               *
+* PURPOSE: Swept test of a box moving by (dx, dy) against a still box: the		*
+*					 whole path is tested, so no move is too fast to be caught.						*
+*					 A box already overlapping or touching and moving away is not a hit		*
+* ARGUMENT LIST:                                                                *
+*                                                                               *
+* Argument  Type         IO     Description                                     *
+* --------- --------     --     ---------------------------------               *
+* moving		Box*				 I			Box at the start of the move										*
+* dx, dy		fix16_t			 I			Move, in px																			*
+* target		Box*				 I			Still box																				*
+* hit				Hit*				 O			Time and normal of the contact									*
+*																																								*
+* RETURN VALUE: 1 if the box hits the target during the move, 0 otherwise      *
+*                                                                               *
+********************************************************************************/
+int Collide_Sweep(const Box *moving, fix16_t dx, fix16_t dy, const Box *target, Hit *hit)
+{
+	fix16_t x_entry, x_exit, y_entry, y_exit, entry, exit;
+
+	if(!SweepAxis(moving->x, moving->w, dx, target->x, target->w, &x_entry, &x_exit) ||
+		!SweepAxis(moving->y, moving->h, dy, target->y, target->h, &y_entry, &y_exit))
+	{
+		return 0;
+	}
+	entry = x_entry > y_entry ? x_entry : y_entry;
+	exit = x_exit < y_exit ? x_exit : y_exit;
+	if(entry >= exit || entry < 0 || entry > FIX_ONE)
+	{
+		return 0;
+	}
+
+	hit->t = entry;
+	hit->nx = x_entry == entry ? (dx > 0 ? -1 : 1) : 0;
+	hit->ny = y_entry == entry ? (dy > 0 ? -1 : 1) : 0;
+	return 1;
+}
+
+/********************************************************************************
+*                                                                               *
+* FUNCTION NAME: Collide_First		                                              *
+*                                                                               *
+* PURPOSE: Swept test against several boxes, the earliest contact wins				*
+* ARGUMENT LIST:                                                                *
+*                                                                               *
+* Argument  Type         IO     Description                                     *
+* --------- --------     --     ---------------------------------               *
+* moving		Box*				 I			Box at the start of the move										*
+* dx, dy		fix16_t			 I			Move, in px																			*
+* targets		Box*				 I			Still boxes																			*
+* count			int					 I			Number of targets																*
+* hit				Hit*				 O			Time and normal of the first contact						*
+*																																								*
+* RETURN VALUE: index of the box hit first, -1 if none                         *
+*                                                                               *
+********************************************************************************/
+int Collide_First(const Box *moving, fix16_t dx, fix16_t dy, const Box *targets, int count, Hit *hit)
+{
+	Hit h;
+	int i, first = -1;
+
+	for(i = 0; i < count; i++)
+	{
+		if(Collide_Sweep(moving, dx, dy, &targets[i], &h) && (first < 0 || h.t < hit->t))
+		{
+			*hit = h;
+			first = i;
+		}
+	}
+	return first;
+}
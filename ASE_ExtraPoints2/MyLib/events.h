@@ -0,0 +1,34 @@
+#include <stdint.h>
+
+#ifndef __EVENTS_H
+#define __EVENTS_H
+
+/*
+ * Events from the interrupts to the loop in main, in a ring with no lock: the
+ * interrupts only post, the loop takes the events out and does the work. The
+ * posters must be interrupts sharing one NVIC priority: they cannot interrupt
+ * each other, so to the ring they are a single producer, and the loop the
+ * single consumer
+ */
+#define EVENT_QUEUE		32				/* events the ring holds, a power of 2	*/
+
+/* Kinds of event */
+#define EV_PRESS			1					/* an input went down, data is its IN_*				*/
+#define EV_RELEASE		2					/* an input went up, data is its IN_*					*/
+#define EV_LONG				4					/* an input is held down, data is its IN_*		*/
+#define EV_REPEAT			5					/* and still held, data is its IN_*						*/
+
+typedef struct {
+	uint32_t time;							/* us from read_SysTick_us								*/
+	uint16_t kind;							/* EV_*																		*/
+	uint16_t data;
+} Event;
+
+/* Events posted on a full ring, they are lost */
+extern volatile uint32_t events_lost;
+
+int Event_Post(uint16_t kind, uint16_t data);
+int Event_PostAt(uint16_t kind, uint16_t data, uint32_t time);
+int Event_Get(Event *ev);
+
+#endif
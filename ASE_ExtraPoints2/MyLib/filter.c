@@ -0,0 +1,87 @@
+#include "filter.h"
+
+/********************************************************************************
+*                                                                               *
+* FUNCTION NAME: Filter_Reset																										*
+*                                                                               *
+* PURPOSE: The next sample starts the filter again, not from the past						*
+* ARGUMENT LIST:																																*
+*                                                                               *
+* Argument  Type         IO     Description																			*
+* --------- --------     --     ---------------------------------								*
+* f					Filter*			 O			The filter																			*
+*																																								*
+* RETURN VALUE: void																														*
+*                                                                               *
+********************************************************************************/
+void Filter_Reset(Filter *f)
+{
+	f->y = 0;
+	f->a = 0;
+	f->b = 0;
+	f->primed = 0;
+}
+
+/********************************************************************************
+*                                                                               *
+* FUNCTION NAME: Filter_Median3																									*
+*                                                                               *
+* PURPOSE: The middle one of three samples																			*
+* ARGUMENT LIST:																																*
+*                                                                               *
+* Argument  Type         IO     Description																			*
+* --------- --------     --     ---------------------------------								*
+* a, b, c		uint16_t		 I			Samples																					*
+*																																								*
+* RETURN VALUE: uint16_t, the median																						*
+*                                                                               *
+********************************************************************************/
+uint16_t Filter_Median3(uint16_t a, uint16_t b, uint16_t c)
+{
+	if(a > b)
+	{
+		if(b > c)
+		{
+			return b;
+		}
+		return a > c ? c : a;
+	}
+	if(a > c)
+	{
+		return a;
+	}
+	return b > c ? c : b;
+}
+
+/********************************************************************************
+*                                                                               *
+* FUNCTION NAME: Filter_Step																										*
+*                                                                               *
+* PURPOSE: Filter a new sample. The first one fills the median and the IIR			*
+* ARGUMENT LIST:																																*
+*                                                                               *
+* Argument  Type         IO     Description																			*
+* --------- --------     --     ---------------------------------								*
+* f					Filter*			 IO			The filter																			*
+* x					uint16_t		 I			Sample, 12 bits																	*
+*																																								*
+* RETURN VALUE: uint16_t, the filtered sample, 12 bits													*
+*                                                                               *
+********************************************************************************/
+uint16_t Filter_Step(Filter *f, uint16_t x)
+{
+	int32_t m;
+
+	if(!f->primed)
+	{
+		f->a = x;
+		f->b = x;
+		f->y = (int32_t)x << FILTER_FRAC;
+		f->primed = 1;
+	}
+	m = (int32_t)Filter_Median3(f->a, f->b, x) << FILTER_FRAC;
+	f->a = f->b;
+	f->b = x;
+	f->y += (m - f->y) >> FILTER_SHIFT;
+	return (uint16_t)((f->y + (1 << (FILTER_FRAC - 1))) >> FILTER_FRAC);
+}
@@ -0,0 +1,26 @@
+#include <stdint.h>
+
+#ifndef __FILTER_H
+#define __FILTER_H
+
+/*
+ * Filter of the potentiometer, one sample at a time from the ring of the ADC: a
+ * median of 3, for the spikes, then a first order IIR, for the noise. The IIR
+ * state carries 4 more bits than the ADC, so the oversampling adds resolution,
+ * and the paddle follows the knob with a lag of about 2^FILTER_SHIFT samples,
+ * no dead-band. This file has no register, adc/ feeds it
+ */
+#define FILTER_SHIFT		3					/* IIR weight of a sample, 1 / 2^SHIFT			*/
+#define FILTER_FRAC			4					/* bits of the state below the ADC LSB			*/
+
+typedef struct {
+	int32_t y;									/* output, FILTER_FRAC bits of fraction			*/
+	uint16_t a, b;							/* the two samples before, for the median		*/
+	uint16_t primed;						/* 0 until the first sample									*/
+} Filter;
+
+void Filter_Reset(Filter *f);
+uint16_t Filter_Median3(uint16_t a, uint16_t b, uint16_t c);
+uint16_t Filter_Step(Filter *f, uint16_t x);
+
+#endif
@@ -1,122 +1,96 @@
 #include "functs.h"
-#include "../GLCD/AsciiLib.h"
-#include "../timer/timer.h"
+#include "../dac/dac.h"
+#include "sound.h"
+#include "events.h"
+#include "../input/input.h"
+#include "recorder.h"
 
-/* Defined in the RIT timer library */
-extern int start, reset, stop;
+/* State of the board, changed by the buttons and by the end of a game */
+int start = 0;			/* a game is on											*/
+int stop = 0;				/* the game is paused with KEY2			*/
+int reset = 0;			/* a game was lost, INT0 clears it	*/
 
-/* Defined in the adc library */
-extern uint16_t adc_Xposition, adc_Yposition;
-extern uint16_t bot_Xposition, bot_Yposition;
+/* Pixels the scene may repaint in a single frame */
+#define SCENE_BUDGET 2048
 
-/* Old position of the ball */
-uint16_t x_old = MAX_X - 6;
-uint16_t y_old = MAX_Y / 2;
+/* Objects of the scene, bottom to top */
+static SceneObject left_wall, right_wall;
+static SceneObject user_score_obj, bot_score_obj;
 
-/* Actual position of the ball */
-uint16_t ball_Xpos;
-uint16_t ball_Ypos;
+/* Names of the bot levels on the start screen, all of one width */
+static const char *const level_names[BOT_LEVELS] = { "Easy  ", "Normal", "Hard  " };
 
-int score[2] = {0, 0};
+/* The choices of the next game are on the start screen */
+static int choice_shown = 0;
+
+/* Scores on the screen, the bot one reads from its side of the board */
+static Counter score_counter[2];
+Sprite paddle_sprite, bot_sprite, ball_sprites[BALL_POOL];
 
 /********************************************************************************
 *                                                                               *
-* FUNCTION NAME: PutCharReverse 	                                              *
+* FUNCTION NAME: DrawLateralLines                                               *
 *                                                                               *
-* PURPOSE: Print a reverse char on the LCD																			*
+* PURPOSE: Draw the red lateral lines																						*
 * ARGUMENT LIST:                                                                *
 *                                                                               *
 * Argument  Type         IO     Description                                     *
 * --------- --------     --     ---------------------------------               *
-* Xpos			uint16_t		 I			Initial X position															*
-*	Ypos			uint16_t		 I			Initial Y position															*
-*	ASCI			uint8_t			 I			Char to print on the LCD												*
-*	charColor	uint16_t		 I			Color to print the number												*
-*	bkColor		uint16_t		 I			Color to print the background										*
-*																																								*
+*                                                                               *
 * RETURN VALUE: void                                                            *
 *                                                                               *
 ********************************************************************************/
-
-void PutCharReverse( uint16_t Xpos, uint16_t Ypos, uint8_t ASCI, uint16_t charColor, uint16_t bkColor )
+void DrawLateralLines()
 {
-	uint16_t i, j;
-    uint8_t buffer[16], tmp_char;
-    GetASCIICode(buffer,ASCI);  /* ȡģ */
-    for( i=0; i<16; i++ )
-    {
-        tmp_char = buffer[15 - i];
-        for( j=0; j<8; j++ )
-        {
-            if( ((tmp_char >> (j)) & 0x01) == 0x01 )
-            {
-                LCD_SetPoint( Xpos + j, Ypos + i, charColor );  /* ַɫ */
-            }
-            else
-            {
-                LCD_SetPoint( Xpos + j, Ypos + i, bkColor );  /* ɫ */
-            }
-        }
-    }
+	LCD_FillRect(0, 0, 5, MAX_Y, Red);
+	LCD_FillRect(MAX_X - 5, 0, 5, MAX_Y, Red);
 }
 
 /********************************************************************************
 *                                                                               *
-* FUNCTION NAME: GUI_Text_Reverse                                               *
+* FUNCTION NAME: PaintCounter		                                              *
 *                                                                               *
-* PURPOSE: Print a reverse string on the LCD																		*
+* PURPOSE: Scene painter for the scores																					*
 * ARGUMENT LIST:                                                                *
 *                                                                               *
 * Argument  Type         IO     Description                                     *
 * --------- --------     --     ---------------------------------               *
-* Xpos			uint16_t		 I			Initial X position															*
-*	Ypos			uint16_t		 I			Initial Y position															*
-*	str				uint8_t*		 I			String to print on the LCD											*
-*	Color		  uint16_t		 I			Color to print the number												*
-*	bkColor		uint16_t		 I			Color to print the background										*
+* obj				SceneObject* I			Object to paint																	*
 *																																								*
 * RETURN VALUE: void                                                            *
 *                                                                               *
 ********************************************************************************/
+static void PaintCounter(const SceneObject *obj)
+{
+	Counter_Redraw((Counter *)obj->data);
+}
 
-void GUI_Text_Reverse(uint16_t Xpos, uint16_t Ypos, uint8_t *str,uint16_t Color, uint16_t bkColor)
+static void AddObject(SceneObject *obj, uint16_t x, uint16_t y, uint16_t w, uint16_t h, uint16_t color)
 {
-    uint8_t TempChar;
-		size_t i = 0;
-    do
-    {
-				i++;
-        TempChar = *str++;     
-    }
-    while ( *str != 0 );
-		TempChar = *str--;
-		do
-		{
-				TempChar = *str--;
-				PutCharReverse( Xpos, Ypos, TempChar, Color, bkColor );    
-        if( Xpos < MAX_X - 8 )
-        {
-            Xpos += 8;
-        } 
-        else if ( Ypos < MAX_Y - 16 )
-        {
-            Xpos = 0;
-            Ypos += 16;
-        }   
-        else
-        {
-            Xpos = 0;
-            Ypos = 0;
-        } 
-				i--;
-		} while( i != 0);
+	obj->x = x;
+	obj->y = y;
+	obj->w = w;
+	obj->h = h;
+	obj->color = color;
+	obj->paint = NULL;
+	obj->data = NULL;
+	Scene_Add(obj);
+}
+
+static void AddSprite(Sprite *sprite, uint16_t x, uint16_t y, uint16_t w, uint16_t h)
+{
+	Sprite_Init(sprite, x, y, w, h, Green, NULL);
+	sprite->uncover = Scene_Invalidate;
+	Scene_Add(&sprite->obj);
 }
 
 /********************************************************************************
 *                                                                               *
-* FUNCTION NAME: DrawLateralLines                                               *
+* FUNCTION NAME: InitScene				                                              *
 *                                                                               *
-* PURPOSE: Draw the red lateral lines																						*
+* PURPOSE: Describe the game field to the scene, which repaints whatever				*
+*					 the ball uncovers, and show the scores.															*
+*					 The rest of the field must already be drawn													*
 * ARGUMENT LIST:                                                                *
 *                                                                               *
 * Argument  Type         IO     Description                                     *
@@ -125,126 +99,132 @@ void GUI_Text_Reverse(uint16_t Xpos, uint16_t Ypos, uint8_t *str,uint16_t Color,
 * RETURN VALUE: void                                                            *
 *                                                                               *
 ********************************************************************************/
-void DrawLateralLines()
+void InitScene()
 {
-	size_t i;
+	int i;
 	
-	for(i = 0; i < 5; i++)
+	Scene_Init(Black, SCENE_BUDGET);
+	AddObject(&left_wall, 0, 0, 5, MAX_Y, Red);
+	AddObject(&right_wall, MAX_X - 5, 0, 5, MAX_Y, Red);
+	Counter_Init(&score_counter[USER], 6, MAX_Y / 2, 2, 0, White, Black);
+	Counter_Init(&score_counter[BOT], MAX_X - 22, MAX_Y / 2, 2, COUNTER_ROTATED, White, Black);
+	AddObject(&user_score_obj, 6, MAX_Y / 2, 16, 16, White);
+	user_score_obj.paint = PaintCounter;
+	user_score_obj.data = &score_counter[USER];
+	AddObject(&bot_score_obj, MAX_X - 22, MAX_Y / 2, 16, 16, White);
+	bot_score_obj.paint = PaintCounter;
+	bot_score_obj.data = &score_counter[BOT];
+	AddSprite(&paddle_sprite, game.paddle_x, game.paddle_y, 40, 10);
+	AddSprite(&bot_sprite, game.bot_x, game.bot_y - 9, 40, 10);
+	/* The balls are hidden until ShowBalls draws those in play */
+	for(i = 0; i < BALL_POOL; i++)
 	{
-		LCD_DrawLine(i, 0, i, MAX_Y - 1, Red);
-		LCD_DrawLine(MAX_X - 1 - i, 0, MAX_X - 1 - i, MAX_Y - 1, Red);
+		AddSprite(&ball_sprites[i], 0, 0, 0, 0);
 	}
+
+	Counter_Show(&score_counter[USER], game.score[USER]);
+	Counter_Show(&score_counter[BOT], game.score[BOT]);
 }
 
 /********************************************************************************
 *                                                                               *
-* FUNCTION NAME: LCD_PutInt				                                              *
+* FUNCTION NAME: ShowBalls				                                              *
 *                                                                               *
-* PURPOSE: Print a number on the LCD																						*
+* PURPOSE: Draw the balls in play, on a scene just made by InitScene						*
 * ARGUMENT LIST:                                                                *
 *                                                                               *
 * Argument  Type         IO     Description                                     *
 * --------- --------     --     ---------------------------------               *
-* Xpos			uint16_t		 I			Initial X position															*
-*	Ypos			uint16_t		 I			Initial Y position															*
-*	number		int					 I			Number to print on the LCD											*
-*	charColor	uint16_t		 I			Color to print the number												*
-*	bkColor		uint16_t		 I			Color to print the background										*
-*																																								*
+*                                                                               *
 * RETURN VALUE: void                                                            *
 *                                                                               *
 ********************************************************************************/
-void LCD_PutInt(uint16_t Xpos, uint16_t Ypos, int number, uint16_t charColor, uint16_t bkColor)
+void ShowBalls()
 {
-		char ascii[8];
-		sprintf(ascii,"%d",number);
-		if(number < 10)
-		{
-			PutChar(Xpos, Ypos, ascii[0], charColor, bkColor);
-		}
-		else if(number < 100)
-		{
-			PutChar(Xpos, Ypos, ascii[0], charColor, bkColor);
-			PutChar(Xpos + 9, Ypos, ascii[1], charColor, bkColor);
-		}
-		else if(number < 1000)
-		{
-			PutChar(Xpos, Ypos, ascii[0], charColor, bkColor);
-			PutChar(Xpos + 9, Ypos, ascii[1], charColor, bkColor);
-			PutChar(Xpos + 18, Ypos, ascii[2], charColor, bkColor);
-		}
-		else if(number < 10000)
+		int i;
+		
+		for(i = 0; i < game.balls.count; i++)
 		{
-			PutChar(Xpos, Ypos, ascii[0], charColor, bkColor);
-			PutChar(Xpos + 9, Ypos, ascii[1], charColor, bkColor);
-			PutChar(Xpos + 18, Ypos, ascii[2], charColor, bkColor);
-			PutChar(Xpos + 27, Ypos, ascii[3], charColor, bkColor);
+			Sprite_Show(&ball_sprites[i], Pool_Left(&game.balls, i), Pool_Top(&game.balls, i), game.balls.size, game.balls.size);
 		}
+		Scene_Render();
 }
 
 /********************************************************************************
 *                                                                               *
-* FUNCTION NAME: LCD_PutInt_Reverse                                             *
+* FUNCTION NAME: InitBall					                                              *
 *                                                                               *
-* PURPOSE: Print a reverse number on the LCD																		*
+* PURPOSE: Serve the balls and draw them																				*
 * ARGUMENT LIST:                                                                *
 *                                                                               *
 * Argument  Type         IO     Description                                     *
 * --------- --------     --     ---------------------------------               *
-* Xpos			uint16_t		 I			Initial X position															*
-*	Ypos			uint16_t		 I			Initial Y position															*
-*	number		int					 I			Number to print on the LCD											*
-*	charColor	uint16_t		 I			Color to print the number												*
-*	bkColor		uint16_t		 I			Color to print the background										*
-*																																								*
+*                                                                               *
 * RETURN VALUE: void                                                            *
 *                                                                               *
 ********************************************************************************/
-void LCD_PutInt_Reverse(uint16_t Xpos, uint16_t Ypos, int number, uint16_t charColor, uint16_t bkColor)
+void InitBall()
 {
-		char ascii[8];
-		sprintf(ascii,"%d",number);
-		if(number < 10)
-		{
-			PutCharReverse(Xpos, Ypos, ascii[0], charColor, bkColor);
-		}
+		Game_Serve();
+		ShowBalls();
 }
 
 /********************************************************************************
 *                                                                               *
-* FUNCTION NAME: IncrementScore		                                              *
+* FUNCTION NAME: PlayGame					                                              *
 *                                                                               *
-* PURPOSE: Increment the score of the game																			*
+* PURPOSE: One fixed step of the game on the last ADC sample, with its				*
+*					 sounds. Only the scores and the messages are drawn here							*
 * ARGUMENT LIST:                                                                *
 *                                                                               *
 * Argument  Type         IO     Description                                     *
 * --------- --------     --     ---------------------------------               *
-*                                                                               *
-* RETURN VALUE: void                                                            *
+* sample		uint16_t		 I			ADC sample published to the loop								*
+*																																								*
+* RETURN VALUE: the GAME_* events of the step                                   *
 *                                                                               *
 ********************************************************************************/
-void IncrementScore(uint16_t player)
+uint32_t PlayGame(uint16_t sample)
 {
-	score[player] += 1;
-	if(player == USER)
+	uint32_t events = Game_Step(sample);
+	uint16_t effect = SOUND_NONE;
+	
+	if(events & GAME_HIT)
+	{
+		effect = SOUND_PADDLE;
+	}
+	else if(events & GAME_BOUNCE)
+	{
+		effect = SOUND_WALL;
+	}
+	/* With more balls both players may score in the same step */
+	if(events & GAME_POINT_USER)
 	{
-		LCD_PutInt(6, MAX_Y / 2, score[USER], White, Black);
+		effect = SOUND_SCORE;
+		Counter_Show(&score_counter[USER], game.score[USER]);
 	}
-	else if(player == BOT)
+	if(events & GAME_POINT_BOT)
 	{
-		LCD_PutInt_Reverse(MAX_X - 41, MAX_Y / 2, score[BOT], White, Black);
+		effect = SOUND_SCORE;
+		Counter_Show(&score_counter[BOT], game.score[BOT]);
 	}
-	if(score[player] == 5)
+	/* The step ends at the first point to WIN_SCORE, the winner is the one who has it */
+	if(events & GAME_OVER)
 	{
-		GameLost(player);
+		effect = SOUND_LOSE;
+		GameLost(game.score[USER] == WIN_SCORE ? USER : BOT);
 	}
+	/* One sound per step, the queue merges the ones that come too fast */
+	Sound_Play(effect);
+	return events;
 }
 
 /********************************************************************************
 *                                                                               *
-* FUNCTION NAME: InitBall					                                              *
+* FUNCTION NAME: RenderGame				                                              *
 *                                                                               *
-* PURPOSE: Initialize the ball's position																				*
+* PURPOSE: Draw the sprites where the last steps left them: only the pixels	*
+*					 that change are drawn, the scene repaints what the sprites leave		*
 * ARGUMENT LIST:                                                                *
 *                                                                               *
 * Argument  Type         IO     Description                                     *
@@ -253,268 +233,191 @@ void IncrementScore(uint16_t player)
 * RETURN VALUE: void                                                            *
 *                                                                               *
 ********************************************************************************/
-void InitBall()
+void RenderGame()
 {
-		size_t i;
-	
-		ball_Xpos = MAX_X - 6;
-		ball_Ypos = MAX_Y / 2;
-	
-		for(i = 0; i < 5; i++)
-		{
-			LCD_DrawLine(x_old - 4, y_old - i, x_old, y_old - i, Black);
-			LCD_DrawLine(ball_Xpos - 4, ball_Ypos - i, ball_Xpos, ball_Ypos - i,Green);
-		}
+	const BallPool *balls = &game.balls;
+	int i;
 	
-		x_old = MAX_X - 6;
-		y_old = MAX_Y / 2;
-		ball_Xpos -=1;
-		ball_Ypos +=1;
+	Sprite_MoveTo(&paddle_sprite, game.paddle_x, game.paddle_y);
+	/* The bot paddle ends in bot_y */
+	Sprite_MoveTo(&bot_sprite, game.bot_x, game.bot_y - 9);
+	for(i = 0; i < balls->count; i++)
+	{
+		Sprite_MoveTo(&ball_sprites[i], Pool_Left(balls, i), Pool_Top(balls, i));
+	}
+	Scene_Render();
 }
 
 /********************************************************************************
 *                                                                               *
-* FUNCTION NAME: MoveBall					                                              *
+* FUNCTION NAME: GameLost					                                              *
 *                                                                               *
-* PURPOSE: Function to calculate the next ball's position based on							*
-*						where the current position is																				*
+* PURPOSE: Function to be called when the game is lost,													*
+*						that's when the ball goes below the paddle													*
 * ARGUMENT LIST:                                                                *
 *                                                                               *
 * Argument  Type         IO     Description                                     *
 * --------- --------     --     ---------------------------------               *
-*                                                                               *
+* player		uint16_t		 I			The winner, USER or BOT													*
+*																																								*
 * RETURN VALUE: void                                                            *
 *                                                                               *
 ********************************************************************************/
-void MoveBall()
+void GameLost(uint16_t player)
 {
-		
-	  static uint16_t x_new, y_new;
-		static uint16_t adc_Xold, bot_Xold;
-		static int speed;
-		size_t i;
-		for(i = 0; i < 5; i++)
-		{
-			/* Delete previous ball */
-			LCD_DrawLine(x_old - i, y_old - 4, x_old - i, y_old, Black);
-		}
-		for(i = 0; i < 5; i++)
-		{
-			/* Draw the ball */
-			LCD_DrawLine(ball_Xpos - i, ball_Ypos - 4, ball_Xpos - i, ball_Ypos, Green);
-		}
-		
-		/* Calculate next position */
-		if(ball_Xpos >= MAX_BALLX || (ball_Xpos - 4) <= MIN_BALLX || 
-			((ball_Ypos < (adc_Yposition - 4 && (ball_Ypos - 4) > adc_Yposition)) 
-			&& (ball_Xpos == (adc_Xposition + 39) || (ball_Xpos - 4) == adc_Xposition)))
-		{
-			/* If the ball's in one of the two top edges */
-			if(ball_Ypos - 4 <= MIN_BALLY)
-			{
-				x_new = x_old;
-				y_new = y_old;
-				disable_timer(0);
-				reset_timer(0);
-				init_timer(0,1263);
-				enable_timer(0);
-			}
-			/* If the ball is on one of the two potentiometer top angles */
-			else if(ball_Xpos == adc_Xposition && (ball_Ypos == (adc_Yposition - 4 || (ball_Ypos - 4) == adc_Yposition)))
-			{
-				x_new = x_old;
-				y_new = y_old;
-				
-				//IncrementScore(USER);
-				disable_timer(0);
-				reset_timer(0);
-				init_timer(0,1062);
-				enable_timer(0);
-			}
-			/* If the ball's on one of the two lateral walls or on the side of the paddle*/
-			else
-			{
-				x_new = x_old;
-				y_new = 2 * ball_Ypos - y_old;
-				disable_timer(0);
-				reset_timer(0);
-				init_timer(0,1263);
-				enable_timer(0);
-			}
-			
-			
-		}
-		/* If the ball is on */
-		else if(ball_Ypos - 4 <= MIN_BALLY)
-		{
-			x_new = 2 * ball_Xpos - x_old;
-			y_new = y_old;
-			/* Low pitch tone */
-			disable_timer(0);
-			reset_timer(0);
-			init_timer(0,1263);
-			enable_timer(0);
-		}
-		/* if the ball is touching the top of the USER paddle */
-		else if((ball_Ypos > adc_Yposition - 4 && ball_Ypos <= adc_Yposition + 9) && (ball_Xpos > adc_Xposition && (ball_Xpos - 4) < (adc_Xposition + 39)))
-		{
-			/* 
-			 * The next position varies on the speed of the paddle, 
-			 * calculated using its previous and next position 
+			/* Put reset to 1 and start to zero, 
+			 * then print the losing message
+			 * finally wait for the start button to be pushed,
+			 * resetting the game
 			 */
-			speed = (int)(adc_Xposition - adc_Xold);
-			x_new = (2 * ball_Xpos - x_old);
-			y_new = y_old;
-			
-			if((int)(ball_Xpos - x_old) < 0)
-			{
-				y_new = (y_new - 1 == y_old) ? y_new : y_new - 1;
-			}
-			else if((int)(ball_Xpos - x_old) > 0)
+			reset = 1;
+			start = 0;
+			/* What is printed on the screen depends on who's the one that loses the game */
+			if(player == USER)
 			{
-				if(speed > 0)
-				{
-					x_new = (x_new + 1 == x_old) ? x_new : x_new + 1;
-				}
-				else
-				{
-					x_new = (x_new - 1 == x_old) ? x_new : x_new - 1;
-				}
+				GUI_Text(MAX_X/2 - 50, MAX_Y / 2 + 50, "You Win", White, Black);
+				GUI_TextRotated(MAX_X/2 - 50, MAX_Y / 2 - 50, "You Lose", White, Black, 180);
 			}
-			disable_timer(0);
-			reset_timer(0);
-			init_timer(0,1062);
-			enable_timer(0);
-		}
-		/* if the ball is touching the top of the BOT paddle */
-		else if((ball_Ypos - 4 <= bot_Yposition && ball_Ypos - 4 > bot_Yposition - 9) && (ball_Xpos > bot_Xposition && (ball_Xpos - 4) < (bot_Xposition + 39)))
-		{
-			/* 
-			 * The next position varies on the speed of the paddle, 
-			 * calculated using its previous and next position 
-			 */
-			speed = (int)(bot_Xposition - bot_Xold);
-			x_new = (2 * ball_Xpos - x_old);
-			y_new = y_old;
-			
-			if((int)(ball_Xpos - x_old) < 0)
+			else
 			{
-				y_new = (y_new - 1 == y_old) ? y_new : y_new - 1;
+				GUI_TextRotated(MAX_X/2 - 50, MAX_Y / 2 - 50, "You Win", White, Black, 180);
+				GUI_Text(MAX_X/2 - 50, MAX_Y / 2 + 50, "You Lose", White, Black);
 			}
-			else if((int)(ball_Xpos - x_old) > 0)
+			GUI_Text(MAX_X/2 - 100, MAX_Y / 2 + 15, "Press INT0 to Reset", White, Black);
+			GUI_Text(MAX_X/2 - 100, MAX_Y / 2 + 30, "Press KEY2 to Replay", White, Black);
+}
+
+/********************************************************************************
+*                                                                               *
+* FUNCTION NAME: PressButton			                                              *
+*                                                                               *
+* PURPOSE: What a button does in the state of the board, called by the loop			*
+*					 in main for the EV_PRESS events. A button that has nothing to do			*
+*					 is ignored																														*
+* ARGUMENT LIST:                                                                *
+*                                                                               *
+* Argument  Type         IO     Description                                     *
+* --------- --------     --     ---------------------------------               *
+* button		uint16_t		 I			IN_INT0, IN_KEY1 or IN_KEY2											*
+*																																								*
+* RETURN VALUE: the PRESS_* outcome                                             *
+*                                                                               *
+********************************************************************************/
+uint32_t PressButton(uint16_t button)
+{
+	switch(button)
+	{
+		case IN_INT0:
+			/* After a lost game INT0 clears the screen for a new one */
+			if(reset == 1 && start == 0)
 			{
-				if(speed > 0)
-				{
-					x_new = (x_new + 1 == x_old) ? x_new : x_new + 1;
-				}
-				else
-				{
-					x_new = (x_new - 1 == x_old) ? x_new : x_new - 1;
-				}
+				reset = 0;
+				LCD_Clear(Black);
+				GUI_Text(MAX_X / 2 - 100, MAX_Y / 2, "Press KEY1 to Restart", White, Black);
+				choice_shown = 0;
+				return PRESS_RESET;
 			}
-			disable_timer(0);
-			reset_timer(0);
-			init_timer(0,1062);
-			enable_timer(0);
-		}
-		/* In each other case, when the ball is in the middle of the display */
-		else
-		{
-			x_new = 2 * ball_Xpos - x_old;
-			y_new = 2 * ball_Ypos - y_old;
-		}
-		
-		/* Just to be sure that the number is still visible */
-		if(ball_Xpos < 27 && (ball_Ypos < MAX_Y / 2 && ball_Ypos > MAX_Y / 2 + 9))
-		{
-			LCD_PutInt(6, MAX_Y / 2, score[USER], White, Black);
-		}
-		else if(ball_Xpos > MAX_X - 41  && (ball_Ypos < MAX_Y / 2 && ball_Ypos > MAX_Y / 2 + 9))
-		{
-			LCD_PutInt(MAX_X - 35 - 6, MAX_Y / 2, score[BOT], White, Black);
-		}
-		/* Just to keep the integrity of the game environment */
-		if(x_old <= MIN_BALLX)
-		{
-			for(i = 0; i < 5; i++)
+			break;
+		case IN_KEY1:
+			/* At the beginning or after INT0 KEY1 starts a new game */
+			if(reset == 0 && start == 0)
 			{
-				LCD_DrawLine(i, 0, i, adc_Yposition, Red);
+				Game_Start();
+				GUI_Text(MAX_X / 2 - 100, MAX_Y / 2, "Press KEY1 to Start  ", Black, Black);
+				LCD_FillRect(0, MAX_Y / 2 + 24, MAX_X, 32, Black);
+				choice_shown = 0;
+				DrawLateralLines();
+				/* Init Paddle position */
+				LCD_FillRect(game.paddle_x, game.paddle_y, 40, 10, Green);
+				LCD_FillRect(game.bot_x, game.bot_y - 9, 40, 10, Green);
+				InitScene();
+				InitBall();
+				start = 1;
+				stop = 0;
+				return PRESS_START;
 			}
-		}
-		else if(x_old >= MAX_BALLX)
-		{
-			for(i = 0; i < 5; i++)
+			break;
+		case IN_KEY2:
+			/* While a game is on KEY2 pauses it and resumes it */
+			if(start == 1)
 			{
-				LCD_DrawLine(MAX_X - 1 - i, 0, MAX_X - 1 - i, adc_Yposition, Red);
+				stop = !stop;
+				return PRESS_PAUSE;
 			}
-		}
-		else if(y_old - 4 < MIN_BALLY)
-		{
-			for(i = 0; i < 5; i++)
+			/* After a lost game the game is played again from its recording, where it started */
+			if(reset == 1 && Replay_Start())
 			{
-				LCD_DrawLine(0, i, MAX_X - 1, i, Red);
+				reset = 0;
+				LCD_Clear(Black);
+				DrawLateralLines();
+				LCD_FillRect(game.paddle_x, game.paddle_y, 40, 10, Green);
+				LCD_FillRect(game.bot_x, game.bot_y - 9, 40, 10, Green);
+				InitScene();
+				ShowBalls();
+				start = 1;
+				stop = 0;
+				return PRESS_REPLAY;
 			}
-		}
-		
-		/* Update the values */
-		x_old = ball_Xpos;
-		y_old = ball_Ypos;
-		ball_Xpos = x_new;
-		ball_Ypos = y_new;
-		adc_Xold = adc_Xposition;
-		bot_Xold = bot_Xposition;
-		
-		/* If the position is lower than the end of the paddle, than it's point to the respective player */
-		if(ball_Ypos - 4 > MAX_BALLY)
-		{
-			IncrementScore(BOT);
-			InitBall();
-		} 
-		else if(ball_Ypos < MAX_BALL_BOT)
-		{
-			IncrementScore(USER);
-			InitBall();
-		}
+			break;
+		default:
+			break;
+	}
+	return PRESS_NONE;
 }
 
 /********************************************************************************
 *                                                                               *
-* FUNCTION NAME: GameLost					                                              *
+* FUNCTION NAME: ChooseGame				                                              *
 *                                                                               *
-* PURPOSE: Function to be called when the game is lost,													*
-*						that's when the ball goes below the paddle													*
+* PURPOSE: The choices of the next game, on the start screen only: the					*
+*					 joystick left and right change the level of the bot, up and down			*
+*					 the balls of a serve. Drawn when they change or the screen was				*
+*					 cleared																															*
 * ARGUMENT LIST:                                                                *
 *                                                                               *
 * Argument  Type         IO     Description                                     *
 * --------- --------     --     ---------------------------------               *
-*                                                                               *
+* pressed		uint16_t		 I			Bits 1 << IN_* of the inputs down since the			*
+*														last call																				*
+*																																								*
 * RETURN VALUE: void                                                            *
 *                                                                               *
 ********************************************************************************/
-void GameLost(uint16_t player)
+void ChooseGame(uint16_t pressed)
 {
-			/* Put reset to 1 and start to zero, 
-			 * then print the losing message
-			 * finally wait for the start button to be pushed,
-			 * resetting the game
-			 */
-			reset = 1;
-			start = 0;
-			/* What is printed on the screen depends on who's the one that loses the game */
-			if(player == USER)
-			{
-				GUI_Text(MAX_X/2 - 50, MAX_Y / 2 + 50, "You Win", White, Black);
-				GUI_Text_Reverse(MAX_X/2 - 50, MAX_Y / 2 - 50, "You Lose", White, Black);
-			}
-			else
-			{
-				GUI_Text_Reverse(MAX_X/2 - 50, MAX_Y / 2 - 50, "You Win", White, Black);
-				GUI_Text(MAX_X/2 - 50, MAX_Y / 2 + 50, "You Lose", White, Black);
-			}
-			disable_timer(0);
-			reset_timer(0);
-			init_timer(0,2048);
-			enable_timer(0);
-			GUI_Text(MAX_X/2 - 100, MAX_Y / 2 + 15, "Press INT0 to Reset", White, Black);
-			NVIC_EnableIRQ(EINT0_IRQn);
+	uint16_t level = game.bot_level, balls = game.served;
+	uint8_t count[2];
+	
+	if(start == 1 || reset == 1)
+	{
+		return;
+	}
+	if((pressed & (1 << IN_LEFT)) && level > BOT_EASY)
+	{
+		level--;
+	}
+	if((pressed & (1 << IN_RIGHT)) && level < BOT_HARD)
+	{
+		level++;
+	}
+	if((pressed & (1 << IN_UP)) && balls < BALL_POOL)
+	{
+		balls++;
+	}
+	if((pressed & (1 << IN_DOWN)) && balls > 1)
+	{
+		balls--;
+	}
+	if(level != game.bot_level || balls != game.served || !choice_shown)
+	{
+		Game_SetLevel(level);
+		Game_SetBalls(balls);
+		count[0] = '0' + balls;
+		count[1] = 0;
+		GUI_Text(MAX_X / 2 - 100, MAX_Y / 2 + 24, "Bot (left/right):", White, Black);
+		GUI_Text(MAX_X / 2 + 44, MAX_Y / 2 + 24, (uint8_t *)level_names[level], White, Black);
+		GUI_Text(MAX_X / 2 - 100, MAX_Y / 2 + 40, "Balls (up/down):", White, Black);
+		GUI_Text(MAX_X / 2 + 44, MAX_Y / 2 + 40, count, White, Black);
+		choice_shown = 1;
+	}
 }
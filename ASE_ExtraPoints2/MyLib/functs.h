@@ -1,31 +1,38 @@
-#include <stdio.h>
 #include "LPC17xx.H"                    /* LPC17xx definitions                */
 #include "../GLCD/GLCD.h" 
 #include "../TouchPanel/TouchPanel.h"
 #include "../led/led.h"
 #include "../adc/adc.h"
-
-/* Player ID */
-#define USER	0
-#define BOT		1
+#include "scene.h"
+#include "sprite.h"
+#include "counter.h"
+#include "game.h"
 
 /* Potentiometer edge positions */
 #define MIN_POT 6
 #define MAX_POT MAX_X - 6
 
-/* Ball edge positions on both axis */
-#define MIN_BALLX 6
-#define MAX_BALLX MAX_X - 6
+/* Sprites of the game, defined in functs.c */
+extern Sprite paddle_sprite, bot_sprite, ball_sprites[BALL_POOL];
+
+/* State of the board, defined in functs.c and changed by the loop in main only */
+extern int start, stop, reset;
 
-#define MIN_BALLY 6
-#define MAX_BALLY MAX_Y - 33
+/* What a button press did, for the game loop */
+#define PRESS_NONE		0
+#define PRESS_START		1			/* KEY1 started a new game						*/
+#define PRESS_REPLAY	2			/* KEY2 started the last game again		*/
+#define PRESS_PAUSE		3			/* KEY2 paused or resumed the game		*/
+#define PRESS_RESET		4			/* INT0 cleared the lost game					*/
 
-#define MAX_BALL_BOT 31
 
 uint32_t ASCIItoUnsig(uint8_t *str, uint32_t size);
 void InitBall(void);
-void MoveBall(void);
-void LCD_PutInt(uint16_t Xpos, uint16_t Ypos, int number, uint16_t charColor, uint16_t bkColor);
-void PlayGame(void);
+void ShowBalls(void);
+uint32_t PlayGame(uint16_t sample);
+void RenderGame(void);
 void GameLost(uint16_t player);
 void DrawLateralLines(void);
+uint32_t PressButton(uint16_t button);
+void ChooseGame(uint16_t pressed);
+void InitScene(void);
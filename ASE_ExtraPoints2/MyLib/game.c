@@ -0,0 +1,569 @@
+#include "game.h"
+
+/* The first ball starts at the right wall, the bot in the middle at the normal level */
+GameState game = {
+	{{FIX(MAX_X - 10)}, {FIX(MAX_Y / 2 - 4)}, {0}, {0}, {FIX_ONE}, 1, 5},
+	1,
+	{0, 0},
+	MAX_X / 2 - 20, MAX_Y - 31,
+	16, 31,
+	0, 0,
+	0xFF, MAX_X / 2 - 20,
+	0, BOT_NORMAL,
+	BALL_POOL, GAME_BALLS
+};
+
+/* Obstacles of the ball, rebuilt at every step where the paddles are */
+enum { LEFT_WALL, RIGHT_WALL, PADDLE, BOT_PADDLE, OBSTACLES };
+static Box obstacles[OBSTACLES];
+static int16_t paddle_spin, bot_spin;		/* -1, 0 or 1 as the paddles move */
+
+/* Reaction delay, top speed and aim of the bot at each level */
+static const struct {
+	uint16_t delay;					/* steps before the bot reacts to a new direction	*/
+	uint16_t speed;					/* px per step																		*/
+	uint16_t aim;						/* largest error on the predicted x, in px				*/
+} bot_levels[BOT_LEVELS] = {
+	{16, 2, 30},						/* BOT_EASY		*/
+	{8, 3, 24},							/* BOT_NORMAL	*/
+	{3, 5, 16}							/* BOT_HARD		*/
+};
+
+/* GAME_* events of the current step */
+static uint32_t events;
+
+/********************************************************************************
+*                                                                               *
+* FUNCTION NAME: MovePaddle				                                              *
+*                                                                               *
+* PURPOSE: Move the paddle where the potentiometer is: [-  ] to [  -],					*
+*					 clockwise. adc/ filters the sample, half a pixel of hysteresis				*
+*					 keeps it still between two pixels: there is no dead-band							*
+* ARGUMENT LIST:                                                                *
+*                                                                               *
+* Argument  Type         IO     Description                                     *
+* --------- --------     --     ---------------------------------               *
+* sample		uint16_t		 I			Last ADC sample																	*
+*																																								*
+* RETURN VALUE: void                                                            *
+*                                                                               *
+********************************************************************************/
+static void MovePaddle(uint16_t sample)
+{
+	int32_t q;
+	
+	if(sample == game.last_sample)
+	{
+		return;
+	}
+	game.last_sample = sample;
+	
+	if(sample <= MIN_PADDLE)
+	{
+		game.paddle_x = 6;
+		return;
+	}
+	if(sample >= MAX_PADDLE)
+	{
+		game.paddle_x = MAX_X - 46;
+		return;
+	}
+	/* Same run as the clamped ends, in quarters of a pixel: the paddle must not reach the right wall */
+	q = (int32_t)(sample - MIN_PADDLE) * (MAX_X - 52) * 4 / (MAX_PADDLE - MIN_PADDLE) + 6 * 4;
+	/* Half a pixel past the edges of the one it is on: a knob between two does not flicker */
+	if(q >= game.paddle_x * 4 + 6 || q <= game.paddle_x * 4 - 3)
+	{
+		game.paddle_x = (uint16_t)(q / 4);
+	}
+}
+
+/********************************************************************************
+*                                                                               *
+* FUNCTION NAME: FirstBall				                                              *
+*                                                                               *
+* PURPOSE: The ball that reaches the bot paddle first, of those going up				*
+* ARGUMENT LIST:                                                                *
+*                                                                               *
+* Argument  Type         IO     Description                                     *
+* --------- --------     --     ---------------------------------               *
+*                                                                               *
+* RETURN VALUE: uint16_t, index of the ball, BALL_POOL if none goes up          *
+*                                                                               *
+********************************************************************************/
+static uint16_t FirstBall()
+{
+	const BallPool *balls = &game.balls;
+	fix16_t steps, best = 0;
+	uint16_t i, first = BALL_POOL;
+	
+	for(i = 0; i < balls->count; i++)
+	{
+		if(balls->vy[i] >= 0)
+		{
+			continue;
+		}
+		/* Steps while the top of the ball climbs to the bot paddle */
+		steps = FIX_DIV(balls->y[i] - FIX(game.bot_y + 1), FIX_MUL(-balls->vy[i], balls->speed[i]));
+		if(first == BALL_POOL || steps < best)
+		{
+			first = i;
+			best = steps;
+		}
+	}
+	return first;
+}
+
+/********************************************************************************
+*                                                                               *
+* FUNCTION NAME: PredictBot				                                              *
+*                                                                               *
+* PURPOSE: Where the bot paddle has to be to send a ball back:									*
+*					 the ball is followed to the bot paddle through the wall bounces,		*
+*					 the walls unfolded as mirrors. No ball coming up brings the bot			*
+*					 back to the middle. Called only when the bot has to react						*
+* ARGUMENT LIST:                                                                *
+*                                                                               *
+* Argument  Type         IO     Description                                     *
+* --------- --------     --     ---------------------------------               *
+* i					uint16_t		 I			Ball to send back, BALL_POOL for none						*
+*																																								*
+* RETURN VALUE: void                                                            *
+*                                                                               *
+********************************************************************************/
+static void PredictBot(uint16_t i)
+{
+	const BallPool *balls = &game.balls;
+	fix16_t span, x;
+	int16_t target;
+	
+	game.bot_ball = i;
+	game.bot_wait = bot_levels[game.bot_level].delay;
+	if(i == BALL_POOL)
+	{
+		game.bot_target = MAX_X / 2 - 20;
+		return;
+	}
+	
+	/* Horizontal run while the top of the ball climbs to the bot paddle */
+	x = FIX_DIV(FIX_MUL(balls->y[i] - FIX(game.bot_y + 1), balls->vx[i]), -balls->vy[i]);
+	
+	/* Left edge of the ball in [0, span] from the left wall, reflected back in it */
+	span = FIX(MAX_BALLX + 1 - balls->size - MIN_BALLX);
+	x = (balls->x[i] - FIX(MIN_BALLX) + x) % (2 * span);
+	if(x < 0)
+	{
+		x += 2 * span;
+	}
+	if(x > span)
+	{
+		x = 2 * span - x;
+	}
+	
+	/* The middle of the paddle under the middle of the ball, missed by up to aim px */
+	game.bot_seed = game.bot_seed * 1103515245 + 12345;
+	target = MIN_BALLX + FIX_INT(x) + balls->size / 2 - 20;
+	target += (int16_t)((game.bot_seed >> 16) % (2 * bot_levels[game.bot_level].aim + 1)) - bot_levels[game.bot_level].aim;
+	if(target < 6)
+	{
+		target = 6;
+	}
+	else if(target > MAX_X - 46)
+	{
+		target = MAX_X - 46;
+	}
+	game.bot_target = target;
+}
+
+/********************************************************************************
+*                                                                               *
+* FUNCTION NAME: MoveBot					                                              *
+*                                                                               *
+* PURPOSE: Move the paddle of the bot towards the last prediction, after the		*
+*					 reaction delay and at the speed of the level													*
+* ARGUMENT LIST:                                                                *
+*                                                                               *
+* Argument  Type         IO     Description                                     *
+* --------- --------     --     ---------------------------------               *
+*                                                                               *
+* RETURN VALUE: void                                                            *
+*                                                                               *
+********************************************************************************/
+static void MoveBot()
+{
+	uint16_t speed = bot_levels[game.bot_level].speed;
+	
+	if(game.bot_wait > 0)
+	{
+		game.bot_wait--;
+	}
+	else if(game.bot_x + speed < game.bot_target)
+	{
+		game.bot_x += speed;
+	}
+	else if(game.bot_x > game.bot_target + speed)
+	{
+		game.bot_x -= speed;
+	}
+	else
+	{
+		game.bot_x = game.bot_target;
+	}
+}
+
+/********************************************************************************
+*                                                                               *
+* FUNCTION NAME: IncrementScore		                                              *
+*                                                                               *
+* PURPOSE: Give a point to a player																							*
+* ARGUMENT LIST:                                                                *
+*                                                                               *
+* Argument  Type         IO     Description                                     *
+* --------- --------     --     ---------------------------------               *
+* player		uint16_t		 I			USER or BOT																			*
+*																																								*
+* RETURN VALUE: void                                                            *
+*                                                                               *
+********************************************************************************/
+static void IncrementScore(uint16_t player)
+{
+	/* Two balls may go out in the step that ends the game */
+	if(events & GAME_OVER)
+	{
+		return;
+	}
+	game.score[player] += 1;
+	events |= player == USER ? GAME_POINT_USER : GAME_POINT_BOT;
+	if(game.score[player] == WIN_SCORE)
+	{
+		events |= GAME_OVER;
+	}
+}
+
+/********************************************************************************
+*                                                                               *
+* FUNCTION NAME: ServedBall				                                              *
+*                                                                               *
+* PURPOSE: A ball as a serve puts it in play, at speed 1: the first one leaves	*
+*					 the right wall towards the bottom left, the others follow it to the	*
+*					 left and higher up, every other one towards the right								*
+* ARGUMENT LIST:                                                                *
+*                                                                               *
+* Argument  Type         IO     Description                                     *
+* --------- --------     --     ---------------------------------               *
+* i					int					 I			Index of the ball in the serve									*
+* ball			Ball*				 O			Ball																						*
+*																																								*
+* RETURN VALUE: void                                                            *
+*                                                                               *
+********************************************************************************/
+static void ServedBall(int i, Ball *ball)
+{
+	Ball_Init(ball, MAX_BALLX - 4 - 28 * i, MAX_Y / 2 - 4 - 12 * i, 5, (i & 1) ? FIX_ONE : -FIX_ONE, FIX_ONE);
+}
+
+/********************************************************************************
+*                                                                               *
+* FUNCTION NAME: SetBox						                                              *
+*                                                                               *
+* PURPOSE: Place an obstacle of the ball																				*
+* ARGUMENT LIST:                                                                *
+*                                                                               *
+* Argument  Type         IO     Description                                     *
+* --------- --------     --     ---------------------------------               *
+* box				Box*				 O			Obstacle																				*
+*	x, y			int16_t			 I			Top-left corner, in px													*
+*	w, h			int16_t			 I			Size, in px																			*
+*																																								*
+* RETURN VALUE: void                                                            *
+*                                                                               *
+********************************************************************************/
+static void SetBox(Box *box, int16_t x, int16_t y, int16_t w, int16_t h)
+{
+	box->x = FIX(x);
+	box->y = FIX(y);
+	box->w = FIX(w);
+	box->h = FIX(h);
+}
+
+/********************************************************************************
+*                                                                               *
+* FUNCTION NAME: Bounce						                                              *
+*                                                                               *
+* PURPOSE: What a ball does when it hits an obstacle: the flat face of a				*
+*					 paddle sends it back with an angle that depends on where it hits,		*
+*					 anything else reflects it																						*
+* ARGUMENT LIST:                                                                *
+*                                                                               *
+* Argument  Type         IO     Description                                     *
+* --------- --------     --     ---------------------------------               *
+* b					Ball*				 I/O		The ball, on the face it hit										*
+* index			int					 I			Obstacle hit																		*
+* hit				Hit*				 I			Contact																					*
+*																																								*
+* RETURN VALUE: void                                                            *
+*                                                                               *
+********************************************************************************/
+static void Bounce(Ball *b, int index, const Hit *hit)
+{
+	if(index == PADDLE && hit->ny < 0)
+	{
+		Ball_Deflect(b, Ball_Left(b) + 2 - (game.paddle_x + 20), 22, paddle_spin, -1);
+		Ball_SpeedUp(b);
+		events |= GAME_HIT;
+	}
+	else if(index == BOT_PADDLE && hit->ny > 0)
+	{
+		Ball_Deflect(b, Ball_Left(b) + 2 - (game.bot_x + 20), 22, bot_spin, 1);
+		Ball_SpeedUp(b);
+		events |= GAME_HIT;
+	}
+	else
+	{
+		Ball_Reflect(b, hit);
+		events |= GAME_BOUNCE;
+	}
+}
+
+/********************************************************************************
+*                                                                               *
+* FUNCTION NAME: MoveBalls				                                              *
+*                                                                               *
+* PURPOSE: Move every ball in play by one step. A ball past a paddle is a				*
+*					 point and is served again in its place. The bot reacts when the			*
+*					 ball it goes for changes direction or another one comes up first			*
+* ARGUMENT LIST:                                                                *
+*                                                                               *
+* Argument  Type         IO     Description                                     *
+* --------- --------     --     ---------------------------------               *
+*                                                                               *
+* RETURN VALUE: void                                                            *
+*                                                                               *
+********************************************************************************/
+static void MoveBalls()
+{
+		BallPool *balls = &game.balls;
+		fix16_t vx = 0, vy = 0;
+		uint16_t first;
+		int i, served = 0;
+		Ball ball;
+		
+		paddle_spin = game.paddle_x > game.paddle_old ? 1 : game.paddle_x < game.paddle_old ? -1 : 0;
+		bot_spin = game.bot_x > game.bot_old ? 1 : game.bot_x < game.bot_old ? -1 : 0;
+		
+		/* The walls keep the balls in [MIN_BALLX, MAX_BALLX], the bot paddle ends in bot_y */
+		SetBox(&obstacles[LEFT_WALL], MIN_BALLX - 16, -MAX_Y, 16, 3 * MAX_Y);
+		SetBox(&obstacles[RIGHT_WALL], MAX_BALLX + 1, -MAX_Y, 16, 3 * MAX_Y);
+		SetBox(&obstacles[PADDLE], game.paddle_x, game.paddle_y, 40, 10);
+		SetBox(&obstacles[BOT_PADDLE], game.bot_x, game.bot_y - 9, 40, 10);
+		if(game.bot_ball < balls->count)
+		{
+			vx = balls->vx[game.bot_ball];
+			vy = balls->vy[game.bot_ball];
+		}
+		Pool_Move(balls, obstacles, OBSTACLES, Bounce);
+		game.paddle_old = game.paddle_x;
+		game.bot_old = game.bot_x;
+		
+		/* A ball lower than the end of the paddle is a point to the bot, higher than the bot paddle to the user */
+		for(i = 0; i < balls->count; i++)
+		{
+			if(Pool_Bottom(balls, i) - 4 > MAX_BALLY)
+			{
+				IncrementScore(BOT);
+			}
+			else if(Pool_Bottom(balls, i) < MAX_BALL_BOT)
+			{
+				IncrementScore(USER);
+			}
+			else
+			{
+				continue;
+			}
+			ServedBall(i, &ball);
+			Pool_Set(balls, i, &ball);
+			served = 1;
+		}
+		
+		first = FirstBall();
+		if(served || first != game.bot_ball ||
+			 (first < BALL_POOL && (balls->vx[first] != vx || balls->vy[first] != vy)))
+		{
+			PredictBot(first);
+		}
+}
+
+/********************************************************************************
+*                                                                               *
+* FUNCTION NAME: Game_Start				                                              *
+*                                                                               *
+* PURPOSE: Start a new game from zero to zero																		*
+* ARGUMENT LIST:                                                                *
+*                                                                               *
+* Argument  Type         IO     Description                                     *
+* --------- --------     --     ---------------------------------               *
+*                                                                               *
+* RETURN VALUE: void                                                            *
+*                                                                               *
+********************************************************************************/
+void Game_Start()
+{
+	game.score[USER] = 0;
+	game.score[BOT] = 0;
+}
+
+/********************************************************************************
+*                                                                               *
+* FUNCTION NAME: Game_Serve				                                              *
+*                                                                               *
+* PURPOSE: Put the balls of a serve in play, at speed 1													*
+* ARGUMENT LIST:                                                                *
+*                                                                               *
+* Argument  Type         IO     Description                                     *
+* --------- --------     --     ---------------------------------               *
+*                                                                               *
+* RETURN VALUE: void                                                            *
+*                                                                               *
+********************************************************************************/
+void Game_Serve()
+{
+	Ball ball;
+	int i;
+	
+	Pool_Init(&game.balls, 5);
+	for(i = 0; i < game.served; i++)
+	{
+		ServedBall(i, &ball);
+		Pool_Add(&game.balls, &ball);
+	}
+	PredictBot(FirstBall());
+}
+
+/********************************************************************************
+*                                                                               *
+* FUNCTION NAME: Game_SetLevel		                                              *
+*                                                                               *
+* PURPOSE: Choose how well the bot plays, from the next direction change			*
+* ARGUMENT LIST:                                                                *
+*                                                                               *
+* Argument  Type         IO     Description                                     *
+* --------- --------     --     ---------------------------------               *
+* level			uint16_t		 I			BOT_EASY, BOT_NORMAL or BOT_HARD								*
+*																																								*
+* RETURN VALUE: void                                                            *
+*                                                                               *
+********************************************************************************/
+void Game_SetLevel(uint16_t level)
+{
+	if(level < BOT_LEVELS)
+	{
+		game.bot_level = level;
+	}
+}
+
+/********************************************************************************
+*                                                                               *
+* FUNCTION NAME: Game_SetBalls		                                              *
+*                                                                               *
+* PURPOSE: Choose how many balls the next serves put in play										*
+* ARGUMENT LIST:                                                                *
+*                                                                               *
+* Argument  Type         IO     Description                                     *
+* --------- --------     --     ---------------------------------               *
+* balls			uint16_t		 I			1 to BALL_POOL																	*
+*																																								*
+* RETURN VALUE: void                                                            *
+*                                                                               *
+********************************************************************************/
+void Game_SetBalls(uint16_t balls)
+{
+	game.served = balls < 1 ? 1 : balls > BALL_POOL ? BALL_POOL : balls;
+}
+
+/********************************************************************************
+*                                                                               *
+* FUNCTION NAME: Game_Step				                                              *
+*                                                                               *
+* PURPOSE: One fixed step of the game: the paddles, then the balls							*
+* ARGUMENT LIST:                                                                *
+*                                                                               *
+* Argument  Type         IO     Description                                     *
+* --------- --------     --     ---------------------------------               *
+* sample		uint16_t		 I			Last ADC sample of the potentiometer						*
+*																																								*
+* RETURN VALUE: the GAME_* events of the step                                   *
+*                                                                               *
+********************************************************************************/
+uint32_t Game_Step(uint16_t sample)
+{
+	events = 0;
+	MovePaddle(sample);
+	MoveBot();
+	MoveBalls();
+	return events;
+}
+
+/********************************************************************************
+*                                                                               *
+* FUNCTION NAME: Game_Save				                                              *
+*                                                                               *
+* PURPOSE: Take a snapshot of the game, to pause it or to play it again				*
+* ARGUMENT LIST:                                                                *
+*                                                                               *
+* Argument  Type         IO     Description                                     *
+* --------- --------     --     ---------------------------------               *
+* copy			GameState*	 O			Snapshot																				*
+*																																								*
+* RETURN VALUE: void                                                            *
+*                                                                               *
+********************************************************************************/
+void Game_Save(GameState *copy)
+{
+	*copy = game;
+}
+
+/********************************************************************************
+*                                                                               *
+* FUNCTION NAME: Game_Restore			                                              *
+*                                                                               *
+* PURPOSE: Go back to a snapshot: the same samples from there give the same		*
+*					 steps																																*
+* ARGUMENT LIST:                                                                *
+*                                                                               *
+* Argument  Type         IO     Description                                     *
+* --------- --------     --     ---------------------------------               *
+* copy			GameState*	 I			Snapshot taken by Game_Save											*
+*																																								*
+* RETURN VALUE: void                                                            *
+*                                                                               *
+********************************************************************************/
+void Game_Restore(const GameState *copy)
+{
+	game = *copy;
+}
+
+/********************************************************************************
+*                                                                               *
+* FUNCTION NAME: Game_Hash				                                              *
+*                                                                               *
+* PURPOSE: FNV-1a hash of a state, to tell whether two runs went the same way.	*
+*					 The state has no padding, its bytes are hashed in order							*
+* ARGUMENT LIST:                                                                *
+*                                                                               *
+* Argument  Type         IO     Description                                     *
+* --------- --------     --     ---------------------------------               *
+* state			GameState*	 I			State to hash																		*
+*																																								*
+* RETURN VALUE: the hash                                                        *
+*                                                                               *
+********************************************************************************/
+uint32_t Game_Hash(const GameState *state)
+{
+	const uint8_t *byte = (const uint8_t *)state;
+	uint32_t hash = 2166136261u;
+	
+	while(byte < (const uint8_t *)state + sizeof(GameState))
+	{
+		hash = (hash ^ *byte++) * 16777619u;
+	}
+	return hash;
+}
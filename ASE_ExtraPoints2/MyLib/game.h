@@ -0,0 +1,79 @@
+#include "../GLCD/GLCD.h"							/* MAX_X, MAX_Y									*/
+#include "ball.h"
+
+#ifndef __GAME_H
+#define __GAME_H
+
+/*
+ * Rules of the game, with no register and no LCD access: the board feeds them
+ * the ADC samples in functs.c, the host simulation in sim/pong_sim.c
+ */
+
+/* Player ID */
+#define USER	0
+#define BOT		1
+
+/* Levels of the bot */
+#define BOT_EASY		0
+#define BOT_NORMAL	1
+#define BOT_HARD		2
+#define BOT_LEVELS	3
+
+/* Points that win the game */
+#define WIN_SCORE	5
+
+/* Ball edge positions on both axis */
+#define MIN_BALLX 6
+#define MAX_BALLX MAX_X - 6
+
+#define MIN_BALLY 6
+#define MAX_BALLY MAX_Y - 33
+
+#define MAX_BALL_BOT 31
+
+/* ADC samples at the ends of the paddle run */
+#define MAX_PADDLE 0xD60 /* 3424 decimal */
+#define MIN_PADDLE 0x281 /* 641 decimal */
+
+/* Balls of a serve until the joystick picks others on the start screen, up to BALL_POOL:
+ * more than one is the multi-ball mode */
+#define GAME_BALLS		1
+
+/* What happened during a step, for the sounds and the screen */
+#define GAME_BOUNCE			0x01		/* a ball bounced on a wall or on a side of a paddle		*/
+#define GAME_HIT				0x02		/* a paddle sent a ball back														*/
+#define GAME_POINT_USER	0x04		/* a ball went past the bot, it is served again					*/
+#define GAME_POINT_BOT	0x08		/* a ball went past the user, it is served again				*/
+#define GAME_OVER				0x10		/* a point gave WIN_SCORE to its player									*/
+
+/*
+ * State of the game, read only outside game.c: a snapshot is a plain copy of it.
+ * 200 bytes, words first, the fields a step reads next to each other
+ */
+typedef struct {
+	BallPool balls;								/* sub-pixel positions and velocities			*/
+	uint32_t bot_seed;						/* aim error of the bot										*/
+	int score[2];
+	uint16_t paddle_x, paddle_y;	/* top-left pixel of the user paddle			*/
+	uint16_t bot_x, bot_y;				/* bottom-left pixel of the bot paddle		*/
+	uint16_t paddle_old, bot_old;	/* x of the paddles at the last step, for the spin	*/
+	uint16_t last_sample;					/* last ADC sample the paddle moved for		*/
+	uint16_t bot_target;					/* where the bot paddle goes							*/
+	uint16_t bot_wait;						/* steps the bot still waits before moving	*/
+	uint16_t bot_level;						/* BOT_EASY, BOT_NORMAL or BOT_HARD				*/
+	uint16_t bot_ball;						/* ball the bot goes for, BALL_POOL for none	*/
+	uint16_t served;							/* balls of a serve												*/
+} GameState;
+
+extern GameState game;
+
+void Game_Start(void);
+void Game_Serve(void);
+void Game_SetLevel(uint16_t level);
+void Game_SetBalls(uint16_t balls);
+uint32_t Game_Step(uint16_t sample);
+void Game_Save(GameState *copy);
+void Game_Restore(const GameState *copy);
+uint32_t Game_Hash(const GameState *state);
+
+#endif
@@ -0,0 +1,22 @@
+#include <stdint.h>
+
+#ifndef __HANDOFF_H
+#define __HANDOFF_H
+
+/*
+ * What the interrupts hand to the game loop, published as a whole: a writer
+ * fills the copy the loop is not reading, then flips. No interrupt is
+ * disabled. The writers are interrupts sharing one NVIC priority, so that each
+ * one fills and publishes before another writer runs; the loop in main is the
+ * only reader
+ */
+typedef struct {
+	uint16_t sample;						/* newest filtered ADC sample, by ADC_Block	*/
+	uint16_t held;							/* bits 1 << IN_* of the inputs down, by the RIT	*/
+} GameInput;
+
+volatile GameInput *Input_Begin(void);
+void Input_Publish(void);
+void Input_Read(GameInput *in);
+
+#endif
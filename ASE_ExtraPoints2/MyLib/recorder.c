@@ -0,0 +1,305 @@
+#include "recorder.h"
+
+/* Samples and snapshots of the steps [rec_first, rec_steps) of the last game */
+static uint16_t rec_samples[REC_STEPS];
+static GameState rec_keys[REC_KEYS];
+static uint32_t rec_steps, rec_first;
+static uint32_t rec_end;					/* hash of the state after the last step */
+static int rec_done = 0;					/* the game ended, the recording is whole	*/
+
+/* Export going on: the part of the text in exp_line, and the next part */
+#define EXP_BYTES		8					/* bytes of the first snapshot in a part					*/
+#define EXP_STATE		((sizeof(GameState) + EXP_BYTES - 1) / EXP_BYTES)
+static char exp_line[32];
+static uint32_t exp_len, exp_pos;
+static uint32_t exp_part;
+
+/* Next step of the replay */
+static uint32_t replay_step;
+uint32_t replay_mismatch;
+
+/********************************************************************************
+*                                                                               *
+* FUNCTION NAME: Recorder_Start		                                              *
+*                                                                               *
+* PURPOSE: Drop the last recording, a new game starts														*
+* ARGUMENT LIST:                                                                *
+*                                                                               *
+* Argument  Type         IO     Description                                     *
+* --------- --------     --     ---------------------------------               *
+*                                                                               *
+* RETURN VALUE: void                                                            *
+*                                                                               *
+********************************************************************************/
+void Recorder_Start()
+{
+	rec_steps = 0;
+	rec_first = 0;
+	rec_done = 0;
+}
+
+/********************************************************************************
+*                                                                               *
+* FUNCTION NAME: Recorder_Step		                                              *
+*                                                                               *
+* PURPOSE: Record the sample of the next step, before the step runs. When the	*
+*					 buffer is full the oldest REC_KEY steps go, with their snapshot			*
+* ARGUMENT LIST:                                                                *
+*                                                                               *
+* Argument  Type         IO     Description                                     *
+* --------- --------     --     ---------------------------------               *
+* sample		uint16_t		 I			ADC sample the step runs on											*
+*																																								*
+* RETURN VALUE: void                                                            *
+*                                                                               *
+********************************************************************************/
+void Recorder_Step(uint16_t sample)
+{
+	if(rec_steps % REC_KEY == 0)
+	{
+		if(rec_steps - rec_first == REC_STEPS)
+		{
+			rec_first += REC_KEY;
+		}
+		Game_Save(&rec_keys[(rec_steps / REC_KEY) % REC_KEYS]);
+	}
+	rec_samples[rec_steps % REC_STEPS] = sample;
+	rec_steps++;
+}
+
+/********************************************************************************
+*                                                                               *
+* FUNCTION NAME: Recorder_Stop		                                              *
+*                                                                               *
+* PURPOSE: Close the recording when the game ends															*
+* ARGUMENT LIST:                                                                *
+*                                                                               *
+* Argument  Type         IO     Description                                     *
+* --------- --------     --     ---------------------------------               *
+*                                                                               *
+* RETURN VALUE: void                                                            *
+*                                                                               *
+********************************************************************************/
+void Recorder_Stop()
+{
+	rec_end = Game_Hash(&game);
+	rec_done = 1;
+	exp_part = 0;
+	exp_len = 0;
+	exp_pos = 0;
+}
+
+static void PutHex(void (*put)(char c), uint32_t value, int digits)
+{
+	while(digits-- > 0)
+	{
+		put("0123456789abcdef"[(value >> (4 * digits)) & 0xF]);
+	}
+}
+
+static void PutDec(void (*put)(char c), uint32_t value)
+{
+	char digits[10];
+	int n = 0;
+	
+	do
+	{
+		digits[n++] = '0' + value % 10;
+		value /= 10;
+	} while(value != 0);
+	while(n > 0)
+	{
+		put(digits[--n]);
+	}
+}
+
+static void PutText(void (*put)(char c), const char *text)
+{
+	while(*text != 0)
+	{
+		put(*text++);
+	}
+}
+
+static void PutLine(char c)
+{
+	exp_line[exp_len++] = c;
+}
+
+/********************************************************************************
+*                                                                               *
+* FUNCTION NAME: ExportPart				                                              *
+*                                                                               *
+* PURPOSE: Put a part of the text of the recording in exp_line: the head, the	*
+*					 first snapshot EXP_BYTES at a time, each step with the key before		*
+*					 it, the end. Each part is shorter than exp_line											*
+* ARGUMENT LIST:                                                                *
+*                                                                               *
+* Argument  Type         IO     Description                                     *
+* --------- --------     --     ---------------------------------               *
+* part			uint32_t		 I			Part, from 0																		*
+*																																								*
+* RETURN VALUE: 0 past the last part                                            *
+*                                                                               *
+********************************************************************************/
+static int ExportPart(uint32_t part)
+{
+	const uint8_t *byte = (const uint8_t *)&rec_keys[(rec_first / REC_KEY) % REC_KEYS];
+	uint32_t i;
+	
+	exp_len = 0;
+	exp_pos = 0;
+	if(part == 0)
+	{
+		PutText(PutLine, "# pong recording\nstate ");
+	}
+	else if(part <= EXP_STATE)
+	{
+		for(i = (part - 1) * EXP_BYTES; i < part * EXP_BYTES && i < sizeof(GameState); i++)
+		{
+			PutHex(PutLine, byte[i], 2);
+		}
+		if(part == EXP_STATE)
+		{
+			PutLine('\n');
+		}
+	}
+	else if(rec_first + part - 1 - EXP_STATE < rec_steps)
+	{
+		i = rec_first + part - 1 - EXP_STATE;
+		if(i != rec_first && i % REC_KEY == 0)
+		{
+			PutText(PutLine, "key ");
+			PutDec(PutLine, i);
+			PutLine(' ');
+			PutHex(PutLine, Game_Hash(&rec_keys[(i / REC_KEY) % REC_KEYS]), 8);
+			PutLine('\n');
+		}
+		PutDec(PutLine, rec_samples[i % REC_STEPS]);
+		PutLine('\n');
+	}
+	else if(rec_first + part - 1 - EXP_STATE == rec_steps)
+	{
+		PutText(PutLine, "end ");
+		PutDec(PutLine, rec_steps);
+		PutLine(' ');
+		PutHex(PutLine, rec_end, 8);
+		PutLine('\n');
+	}
+	return exp_len != 0;
+}
+
+/********************************************************************************
+*                                                                               *
+* FUNCTION NAME: Recorder_Export	                                              *
+*                                                                               *
+* PURPOSE: Write the recording as text, read back by sim/pong_sim.c -p:				*
+*					 "state" and the bytes of the first snapshot, one sample per line,		*
+*					 "key" and the hash of each later snapshot before its step, "end",		*
+*					 the steps and the hash of the last state. At most chars characters		*
+*					 per call, the next call goes on from there. A new recording stops		*
+*					 the export																														*
+* ARGUMENT LIST:                                                                *
+*                                                                               *
+* Argument  Type         IO     Description                                     *
+* --------- --------     --     ---------------------------------               *
+* put				function		 I			Writes a character (UART_Send on the board)			*
+* chars			uint32_t		 I			Characters to write at most											*
+*																																								*
+* RETURN VALUE: int, 0 once all of it is written                                *
+*                                                                               *
+********************************************************************************/
+int Recorder_Export(void (*put)(char c), uint32_t chars)
+{
+	if(!rec_done)
+	{
+		return 0;
+	}
+	for(; chars > 0; chars--)
+	{
+		if(exp_pos == exp_len)
+		{
+			if(!ExportPart(exp_part))
+			{
+				return 0;
+			}
+			exp_part++;
+		}
+		put(exp_line[exp_pos++]);
+	}
+	return 1;
+}
+
+/********************************************************************************
+*                                                                               *
+* FUNCTION NAME: Replay_Start			                                              *
+*                                                                               *
+* PURPOSE: Go back to the oldest snapshot of the last game, to play it again		*
+* ARGUMENT LIST:                                                                *
+*                                                                               *
+* Argument  Type         IO     Description                                     *
+* --------- --------     --     ---------------------------------               *
+*                                                                               *
+* RETURN VALUE: 0 if no game was recorded to its end                           *
+*                                                                               *
+********************************************************************************/
+int Replay_Start()
+{
+	if(!rec_done)
+	{
+		return 0;
+	}
+	Game_Restore(&rec_keys[(rec_first / REC_KEY) % REC_KEYS]);
+	replay_step = rec_first;
+	replay_mismatch = 0;
+	return 1;
+}
+
+/********************************************************************************
+*                                                                               *
+* FUNCTION NAME: Replay_Next			                                              *
+*                                                                               *
+* PURPOSE: Sample of the next step of the replay. Where a snapshot was taken		*
+*					 the state must be the recorded one																		*
+* ARGUMENT LIST:                                                                *
+*                                                                               *
+* Argument  Type         IO     Description                                     *
+* --------- --------     --     ---------------------------------               *
+* sample		uint16_t*		 O			Recorded ADC sample															*
+*																																								*
+* RETURN VALUE: 0 after the last step                                           *
+*                                                                               *
+********************************************************************************/
+int Replay_Next(uint16_t *sample)
+{
+	if(replay_step == rec_steps)
+	{
+		return 0;
+	}
+	if(replay_step % REC_KEY == 0)
+	{
+		replay_mismatch += Game_Hash(&game) != Game_Hash(&rec_keys[(replay_step / REC_KEY) % REC_KEYS]);
+	}
+	*sample = rec_samples[replay_step % REC_STEPS];
+	replay_step++;
+	return 1;
+}
+
+/********************************************************************************
+*                                                                               *
+* FUNCTION NAME: Replay_Stop			                                              *
+*                                                                               *
+* PURPOSE: End the replay, which must end with the last recorded step in the		*
+*					 last recorded state																									*
+* ARGUMENT LIST:                                                                *
+*                                                                               *
+* Argument  Type         IO     Description                                     *
+* --------- --------     --     ---------------------------------               *
+*                                                                               *
+* RETURN VALUE: void                                                            *
+*                                                                               *
+********************************************************************************/
+void Replay_Stop()
+{
+	replay_mismatch += replay_step != rec_steps || Game_Hash(&game) != rec_end;
+}
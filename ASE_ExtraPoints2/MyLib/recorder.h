@@ -0,0 +1,27 @@
+#include "game.h"
+
+#ifndef __RECORDER_H
+#define __RECORDER_H
+
+/*
+ * Recording of the last game: the ADC sample of every step and a snapshot of the
+ * state every REC_KEY steps. The steps of a game are a function of its start state
+ * and of its samples, so the recording plays the game again frame by frame
+ */
+/* Steps kept, a power of 2: 204 s at the 50 ms GAME_STEP of ExtraPoints1, 102 s at the 25 ms of ExtraPoints2 */
+#define REC_STEPS		4096
+#define REC_KEY			512				/* steps between two snapshots							*/
+#define REC_KEYS		(REC_STEPS / REC_KEY)
+
+/* Snapshots the replay did not go through, for the debugger */
+extern uint32_t replay_mismatch;
+
+void Recorder_Start(void);
+void Recorder_Step(uint16_t sample);
+void Recorder_Stop(void);
+int Recorder_Export(void (*put)(char c), uint32_t chars);
+int Replay_Start(void);
+int Replay_Next(uint16_t *sample);
+void Replay_Stop(void);
+
+#endif
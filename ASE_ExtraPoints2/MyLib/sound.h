@@ -0,0 +1,69 @@
+#include <stdint.h>
+
+#ifndef __SOUND_H
+#define __SOUND_H
+
+/*
+ * Sound effects played by the GPDMA into the DAC, paced by the DACCNTVAL timer
+ * of the DAC. The DMA plays a block of SOUND_PERIODS periods of a sine and
+ * interrupts once at its end, for the next block. A note sets DACCNTVAL for its
+ * pitch and lasts a whole number of blocks. This file has no register: the
+ * blocks, the sequence of an effect and the queue of the effects are made
+ * here, dac/ plays them
+ */
+#define SOUND_SAMPLES		32				/* samples in a period of the sine					*/
+#define SOUND_PERIODS		8					/* periods in a block												*/
+#define SOUND_BLOCK			(SOUND_SAMPLES * SOUND_PERIODS)
+#define SOUND_CLOCK			25000000	/* PCLK of the DAC, CCLK / 4								*/
+#define SOUND_REST_FREQ	1000			/* a rest is timed as a note at this pitch	*/
+
+/* Flag of Sound_NextBlock for a block of silence */
+#define SOUND_REST			0x10000
+
+/* Effects, from the least to the most important */
+#define SOUND_NONE			0
+#define SOUND_WALL			1					/* a ball on a wall													*/
+#define SOUND_PADDLE		2					/* a paddle sent a ball back								*/
+#define SOUND_SCORE			3					/* a point, or a new record									*/
+#define SOUND_LOSE			4					/* the game is over													*/
+#define SOUND_EFFECTS		5
+
+/*
+ * Effects waiting for the one playing. An effect already waiting is not queued
+ * again, and a new effect takes the place of the less important ones waiting:
+ * the queue goes from the most to the least important, one of each at most
+ */
+#define SOUND_QUEUE			(SOUND_EFFECTS - 1)
+
+/* A note of an effect, freq 0 for a rest */
+typedef struct {
+	uint16_t freq;							/* Hz																				*/
+	uint16_t ms;
+} Note;
+
+/* Where an effect is */
+typedef struct {
+	const Note *note;						/* note playing															*/
+	uint16_t notes;							/* notes after it														*/
+	uint16_t blocks;						/* blocks of the note still to play					*/
+} SoundSeq;
+
+/* The effect playing and the ones waiting */
+typedef struct {
+	SoundSeq seq;
+	uint16_t playing;						/* SOUND_NONE when quiet										*/
+	uint16_t queued;
+	uint16_t queue[SOUND_QUEUE];
+	uint32_t coalesced;					/* effects merged into one waiting					*/
+} SoundPlayer;
+
+void Sound_Wave(uint32_t *block);
+uint32_t Sound_Silence(void);
+void Sound_Start(SoundSeq *seq, uint16_t effect);
+uint32_t Sound_NextBlock(SoundSeq *seq);
+uint32_t Sound_Blocks(const Note *note);
+void Sound_Reset(SoundPlayer *player);
+int Sound_Enqueue(SoundPlayer *player, uint16_t effect);
+uint32_t Sound_Next(SoundPlayer *player);
+
+#endif
@@ -0,0 +1,273 @@
+#include "sprite.h"
+
+/********************************************************************************
+*                                                                               *
+* FUNCTION NAME: PaintSprite			                                              *
+*                                                                               *
+* PURPOSE: Scene painter for the sprites with a bitmap													*
+* ARGUMENT LIST:                                                                *
+*                                                                               *
+* Argument  Type         IO     Description                                     *
+* --------- --------     --     ---------------------------------               *
+* obj				SceneObject* I			Object of the sprite to paint										*
+*																																								*
+* RETURN VALUE: void                                                            *
+*                                                                               *
+********************************************************************************/
+static void PaintSprite(const SceneObject *obj)
+{
+	Sprite_Draw((const Sprite *)obj);
+}
+
+/********************************************************************************
+*                                                                               *
+* FUNCTION NAME: DrawPart					                                              *
+*                                                                               *
+* PURPOSE: Draw a part of the sprite with a single window												*
+* ARGUMENT LIST:                                                                *
+*                                                                               *
+* Argument  Type         IO     Description                                     *
+* --------- --------     --     ---------------------------------               *
+* sprite		Sprite*			 I			Sprite to draw																	*
+*	x, y			uint16_t		 I			Top-left corner of the part, on the screen			*
+*	w, h			uint16_t		 I			Size of the part																*
+*																																								*
+* RETURN VALUE: void                                                            *
+*                                                                               *
+********************************************************************************/
+static void DrawPart(const Sprite *sprite, uint16_t x, uint16_t y, uint16_t w, uint16_t h)
+{
+	const uint16_t *row;
+	uint16_t i;
+
+	if(sprite->bitmap == NULL)
+	{
+		LCD_FillRect(x, y, w, h, sprite->obj.color);
+		return;
+	}
+	if(LCD_BeginWrite(x, y, w, h) != 0)
+	{
+		/* The window wraps at its right edge, rows are sent one after the other */
+		row = &sprite->bitmap[(y - sprite->obj.y) * sprite->obj.w + (x - sprite->obj.x)];
+		for(i = 0; i < h && y + i < MAX_Y; i++)
+		{
+			LCD_PushPixels(row, (x + w > MAX_X) ? MAX_X - x : w);
+			row += sprite->obj.w;
+		}
+		LCD_EndWrite();
+	}
+}
+
+/********************************************************************************
+*                                                                               *
+* FUNCTION NAME: Uncover					                                              *
+*                                                                               *
+* PURPOSE: Repaint an area left by the sprite																		*
+* ARGUMENT LIST:                                                                *
+*                                                                               *
+* Argument  Type         IO     Description                                     *
+* --------- --------     --     ---------------------------------               *
+* sprite		Sprite*			 I			Sprite that moved																*
+*	x, y			uint16_t		 I			Top-left corner of the area											*
+*	w, h			uint16_t		 I			Size of the area																*
+*																																								*
+* RETURN VALUE: void                                                            *
+*                                                                               *
+********************************************************************************/
+static void Uncover(const Sprite *sprite, uint16_t x, uint16_t y, uint16_t w, uint16_t h)
+{
+	if(sprite->uncover != NULL)
+	{
+		sprite->uncover(x, y, w, h);
+	}
+	else
+	{
+		LCD_FillRect(x, y, w, h, sprite->bkColor);
+	}
+}
+
+/********************************************************************************
+*                                                                               *
+* FUNCTION NAME: Difference				                                              *
+*                                                                               *
+* PURPOSE: Split the part of rectangle A that is not covered by rectangle B,		*
+*					 both of the sprite's size and overlapping, in at most two						*
+*					 rectangles: the columns A does not share with B, then the rows				*
+* ARGUMENT LIST:                                                                *
+*                                                                               *
+* Argument  Type         IO     Description                                     *
+* --------- --------     --     ---------------------------------               *
+* sprite		Sprite*			 I			Sprite that moved																*
+*	ax, ay		int					 I			Top-left corner of A														*
+*	bx, by		int					 I			Top-left corner of B														*
+*	out				function		 I			Called for every rectangle											*
+*																																								*
+* RETURN VALUE: void                                                            *
+*                                                                               *
+********************************************************************************/
+static void Difference(const Sprite *sprite, int ax, int ay, int bx, int by,
+	void (*out)(const Sprite *, uint16_t, uint16_t, uint16_t, uint16_t))
+{
+	int w = sprite->obj.w, h = sprite->obj.h;
+	int dx = bx - ax, dy = by - ay;
+	int cols = dx > 0 ? dx : -dx;
+	int rows = dy > 0 ? dy : -dy;
+
+	if(cols != 0)
+	{
+		out(sprite, dx > 0 ? ax : ax + w - cols, ay, cols, h);
+	}
+	if(rows != 0)
+	{
+		out(sprite, dx > 0 ? bx : ax, dy > 0 ? ay : ay + h - rows, w - cols, rows);
+	}
+}
+
+/********************************************************************************
+*                                                                               *
+* FUNCTION NAME: Sprite_Init			                                              *
+*                                                                               *
+* PURPOSE: Initialize a sprite, that leaves a Black background when it moves		*
+* ARGUMENT LIST:                                                                *
+*                                                                               *
+* Argument  Type         IO     Description                                     *
+* --------- --------     --     ---------------------------------               *
+* sprite		Sprite*			 O			Sprite to initialize														*
+*	x, y			uint16_t		 I			Top-left corner																	*
+*	w, h			uint16_t		 I			Size in pixels																	*
+*	color			uint16_t		 I			Color, when there is no bitmap									*
+*	bitmap		uint16_t*		 I			w * h RGB565 pixels, or NULL										*
+*																																								*
+* RETURN VALUE: void                                                            *
+*                                                                               *
+********************************************************************************/
+void Sprite_Init(Sprite *sprite, uint16_t x, uint16_t y, uint16_t w, uint16_t h, uint16_t color, const uint16_t *bitmap)
+{
+	sprite->obj.x = x;
+	sprite->obj.y = y;
+	sprite->obj.w = w;
+	sprite->obj.h = h;
+	sprite->obj.color = color;
+	sprite->obj.paint = (bitmap != NULL) ? PaintSprite : NULL;
+	sprite->obj.data = NULL;
+	sprite->bitmap = bitmap;
+	sprite->uncover = NULL;
+	sprite->bkColor = Black;
+}
+
+/********************************************************************************
+*                                                                               *
+* FUNCTION NAME: Sprite_Draw			                                              *
+*                                                                               *
+* PURPOSE: Draw the whole sprite																								*
+* ARGUMENT LIST:                                                                *
+*                                                                               *
+* Argument  Type         IO     Description                                     *
+* --------- --------     --     ---------------------------------               *
+* sprite		Sprite*			 I			Sprite to draw																	*
+*																																								*
+* RETURN VALUE: void                                                            *
+*                                                                               *
+********************************************************************************/
+void Sprite_Draw(const Sprite *sprite)
+{
+	DrawPart(sprite, sprite->obj.x, sprite->obj.y, sprite->obj.w, sprite->obj.h);
+}
+
+/********************************************************************************
+*                                                                               *
+* FUNCTION NAME: Sprite_MoveTo		                                              *
+*                                                                               *
+* PURPOSE: Move a sprite, touching only the pixels that change: the part of		*
+*					 the old position that is not covered anymore is uncovered, the part	*
+*					 of the new position that was not covered before is drawn							*
+* ARGUMENT LIST:                                                                *
+*                                                                               *
+* Argument  Type         IO     Description                                     *
+* --------- --------     --     ---------------------------------               *
+* sprite		Sprite*			 I/O		Sprite to move																	*
+*	x, y			uint16_t		 I			New top-left corner															*
+*																																								*
+* RETURN VALUE: void                                                            *
+*                                                                               *
+********************************************************************************/
+void Sprite_MoveTo(Sprite *sprite, uint16_t x, uint16_t y)
+{
+	int ox = sprite->obj.x, oy = sprite->obj.y;
+	int dx = x - ox, dy = y - oy;
+
+	if(dx == 0 && dy == 0)
+	{
+		return;
+	}
+	sprite->obj.x = x;
+	sprite->obj.y = y;
+
+	if(dx >= sprite->obj.w || -dx >= sprite->obj.w || dy >= sprite->obj.h || -dy >= sprite->obj.h)
+	{
+		/* No overlap, the two positions are handled as a whole */
+		Uncover(sprite, ox, oy, sprite->obj.w, sprite->obj.h);
+		Sprite_Draw(sprite);
+		return;
+	}
+	if(sprite->bitmap != NULL)
+	{
+		/* The content moves with the sprite, every pixel of the new position changes */
+		Difference(sprite, ox, oy, x, y, Uncover);
+		Sprite_Draw(sprite);
+		return;
+	}
+	Difference(sprite, ox, oy, x, y, Uncover);
+	Difference(sprite, x, y, ox, oy, DrawPart);
+}
+
+/********************************************************************************
+*                                                                               *
+* FUNCTION NAME: Sprite_Show			                                              *
+*                                                                               *
+* PURPOSE: Draw a hidden sprite again, with a size															*
+* ARGUMENT LIST:                                                                *
+*                                                                               *
+* Argument  Type         IO     Description                                     *
+* --------- --------     --     ---------------------------------               *
+* sprite		Sprite*			 I/O		Sprite to show																	*
+*	x, y			uint16_t		 I			Top-left corner																	*
+*	w, h			uint16_t		 I			Size																						*
+*																																								*
+* RETURN VALUE: void                                                            *
+*                                                                               *
+********************************************************************************/
+void Sprite_Show(Sprite *sprite, uint16_t x, uint16_t y, uint16_t w, uint16_t h)
+{
+	sprite->obj.x = x;
+	sprite->obj.y = y;
+	sprite->obj.w = w;
+	sprite->obj.h = h;
+	Sprite_Draw(sprite);
+}
+
+/********************************************************************************
+*                                                                               *
+* FUNCTION NAME: Sprite_Hide			                                              *
+*                                                                               *
+* PURPOSE: Uncover the whole sprite and leave it with no size: it stays in the	*
+*					 scene, moving it draws nothing until Sprite_Show											*
+* ARGUMENT LIST:                                                                *
+*                                                                               *
+* Argument  Type         IO     Description                                     *
+* --------- --------     --     ---------------------------------               *
+* sprite		Sprite*			 I/O		Sprite to hide																	*
+*																																								*
+* RETURN VALUE: void                                                            *
+*                                                                               *
+********************************************************************************/
+void Sprite_Hide(Sprite *sprite)
+{
+	if(sprite->obj.w == 0 || sprite->obj.h == 0)
+	{
+		return;
+	}
+	Uncover(sprite, sprite->obj.x, sprite->obj.y, sprite->obj.w, sprite->obj.h);
+	sprite->obj.w = 0;
+	sprite->obj.h = 0;
+}
@@ -1,8 +1,47 @@
 #include <string.h>
+#include <stdint.h>
+
+/*
+ * AD0.5 is converted at ADC_RATE, started by the rising edges of MAT1.0: TIMER1
+ * toggles it at each match of MR0, twice per sample. GPDMA channel 1 copies
+ * each result into the ring at its DONE, so nothing runs on the CPU for a
+ * sample. Every ADC_BLOCK samples its interrupt filters the new ones and
+ * publishes the result in one word, ADC_Latest, and in the GameInput of the
+ * game loop, MyLib/handoff.h
+ */
+#define ADC_RATE			4000			/* samples per second								*/
+#define ADC_PCLK			(SystemFrequency / 4)			/* PCLKSEL0 reset value for TIMER1	*/
+#define ADC_MATCH			(ADC_PCLK / ADC_RATE / 2 - 1)	/* MR0 of TIMER1, toggles MAT1.0	*/
+#define ADC_PERIOD		(2 * (ADC_MATCH + 1))			/* TIMER1 ticks in a sample, of 40 ns	*/
+#define ADC_BLOCK			16				/* samples per GPDMA interrupt, 4 ms	*/
+#define ADC_RING			64				/* ADDR5 words, a power of 2 of blocks	*/
+
+/* The word of ADC_Latest: the filtered sample and a count of the samples */
+#define ADC_VALUE(w)	((uint16_t)((w) & 0xFFF))
+#define ADC_SEQ(w)		((uint16_t)((w) >> 16))
+
+/*
+ * Timing of the blocks, for the debugger. The conversion starts at the match,
+ * so the sampling period is the one of TIMER1: what moves is when the GPDMA
+ * interrupt takes the block. Times in TIMER1 ticks of 40 ns, right while the
+ * interrupt comes within half a sample of its match
+ */
+typedef struct {
+	uint32_t samples;
+	uint32_t overruns;					/* results overwritten before the GPDMA read them	*/
+	uint32_t errors;						/* GPDMA errors, the ring started again			*/
+	uint32_t latency_sum;				/* wraps in about 5 h at 250 blocks a second		*/
+	uint16_t latency_min;				/* from the last match to the interrupt				*/
+	uint16_t latency_max;
+	uint32_t period_min;				/* between two interrupts, ADC_BLOCK * ADC_PERIOD	*/
+	uint32_t period_max;
+} ADCStats;
+
+extern volatile ADCStats adc_stats;
 
 /* lib_adc.c */
 void ADC_init (void);
-void ADC_start_conversion (void);
-/* IRQ_adc.c */
-void MovePotentiometer(void);
-void ADC_IRQHandler(void);
+void ADC_Block (void);
+void ADC_Error (void);
+uint32_t ADC_Latest (void);
+uint16_t ADC_Read (void);
@@ -1,24 +1,167 @@
 #include "lpc17xx.h"
 #include "adc.h"
+#include "../MyLib/filter.h"
+#include "../MyLib/handoff.h"
+
+/* GPDMA request line of the ADC */
+#define DMA_ADC			4
+
+/* A linked list item of the GPDMA: one block of the ring, then the next */
+typedef struct {
+  uint32_t src;
+  uint32_t dst;
+  uint32_t next;
+  uint32_t control;
+} ADCLink;
+
+/* ADDR5 words, written by the GPDMA only */
+static volatile uint32_t ring[ADC_RING];
+static ADCLink link[ADC_RING / ADC_BLOCK];
+static uint32_t head;											/* samples filtered so far					*/
+
+/* The newest filtered sample and the count of samples: one word, written by the interrupt only */
+static volatile uint32_t latest;
+static Filter filter;
+static uint32_t last_tc;									/* TIMER1 count of the last interrupt	*/
+
+volatile ADCStats adc_stats;
+
+/*----------------------------------------------------------------------------
+  Start GPDMA channel 1 on block i of the ring, the others follow in a circle
+ *----------------------------------------------------------------------------*/
+static void StartRing (uint32_t i) {
+  LPC_GPDMACH1->DMACCConfig   = 0;
+  LPC_GPDMACH1->DMACCSrcAddr  = link[i].src;
+  LPC_GPDMACH1->DMACCDestAddr = link[i].dst;
+  LPC_GPDMACH1->DMACCLLI      = link[i].next;
+  LPC_GPDMACH1->DMACCControl  = link[i].control;
+  LPC_GPDMACH1->DMACCConfig   = (1<< 0) |         /* enable                   */
+                                (DMA_ADC<< 1) |   /* from the ADC             */
+                                (2<<11) |         /* peripheral to memory     */
+                                (1<<14) |         /* error interrupt          */
+                                (1<<15);          /* terminal count interrupt */
+}
 
 /*----------------------------------------------------------------------------
   Function that initializes ADC
  *----------------------------------------------------------------------------*/
 void ADC_init (void) {
+  uint32_t i;
 
   LPC_PINCON->PINSEL3 |=  (3UL<<30);      /* P1.31 is AD0.5                     */
 
   LPC_SC->PCONP       |=  (1<<12);      /* Enable power to ADC block          */
 
+  Filter_Reset(&filter);
+  head = 0;
+  latest = 0;
+  adc_stats.samples = 0;
+  adc_stats.overruns = 0;
+  adc_stats.errors = 0;
+  adc_stats.latency_sum = 0;
+  adc_stats.latency_min = 0xFFFF;
+  adc_stats.latency_max = 0;
+  adc_stats.period_min = 0xFFFFFFFF;
+  adc_stats.period_max = 0;
+
   LPC_ADC->ADCR        =  (1<< 5) |     /* select AD0.5 pin                   */
                           (4<< 8) |     /* ADC clock is 25MHz/5               */
+                          (6<<24) |     /* start on the rising edge of MAT1.0 */
                           (1<<21);      /* enable ADC                         */ 
 
-  LPC_ADC->ADINTEN     =  (1<< 8);      /* global enable interrupt            */
+  LPC_ADC->ADINTEN     =  (1<< 5);      /* AD0.5 requests the GPDMA, the ADC IRQ stays off */
+
+  /* The blocks of the ring in a circle, each one ends with an interrupt */
+  for(i = 0; i < ADC_RING / ADC_BLOCK; i++) {
+    link[i].src = (uint32_t)&LPC_ADC->ADDR5;
+    link[i].dst = (uint32_t)&ring[i * ADC_BLOCK];
+    link[i].next = (uint32_t)&link[(i + 1) % (ADC_RING / ADC_BLOCK)];
+    link[i].control = ADC_BLOCK |       /* transfers                          */
+                      (2<<18) | (2<<21) |	/* 32 bit words                     */
+                      (1<<27) |         /* destination increment              */
+                      (1UL<<31);        /* interrupt at the end               */
+  }
+
+  LPC_SC->PCONP       |=  (1<<29);      /* Enable power for the GPDMA         */
+  LPC_GPDMA->DMACConfig =  1;           /* GPDMA enabled, little endian       */
+  LPC_GPDMA->DMACIntTCClear = (1<<1);
+  LPC_GPDMA->DMACIntErrClr  = (1<<1);
+  StartRing(0);
+  NVIC_SetPriority(DMA_IRQn, 3);
+  NVIC_EnableIRQ(DMA_IRQn);
 
-  NVIC_EnableIRQ(ADC_IRQn);             /* enable ADC Interrupt               */
+  /* TIMER1 only paces the ADC: no interrupt, MAT1.0 needs no pin */
+  LPC_SC->PCONP       |=  (1<<2);       /* Enable power to TIMER1             */
+  LPC_TIM1->TCR        =  2;            /* reset                              */
+  LPC_TIM1->MR0        =  ADC_MATCH;
+  LPC_TIM1->MCR        =  (1<< 1);      /* reset on MR0                       */
+  LPC_TIM1->EMR        =  (3<< 4);      /* toggle MAT1.0 on MR0               */
+  LPC_TIM1->TCR        =  1;            /* enable                             */
 }
 
-void ADC_start_conversion (void) {
-	LPC_ADC->ADCR |=  (1<<24);            /* Start A/D Conversion 				*/
-}				 
+/*----------------------------------------------------------------------------
+  Called by the GPDMA IRQ at the end of each block: the timing of the
+  block, then its samples filtered in order and the result published,
+  in its word and to the game loop.
+  TIMER1 restarts at each match, so its count is the time since the
+  match that started the last conversion
+ *----------------------------------------------------------------------------*/
+void ADC_Block (void) {
+  uint32_t tc = LPC_TIM1->TC;
+  uint32_t end = head + ADC_BLOCK;
+  uint32_t data;
+  int32_t period;
+  uint16_t value = 0;
+  volatile GameInput *in;
+
+  if(adc_stats.samples != 0) {
+    period = ADC_BLOCK * ADC_PERIOD + (int32_t)tc - (int32_t)last_tc;
+    if((uint32_t)period < adc_stats.period_min)
+      adc_stats.period_min = period;
+    if((uint32_t)period > adc_stats.period_max)
+      adc_stats.period_max = period;
+  }
+  last_tc = tc;
+  if(tc < adc_stats.latency_min)
+    adc_stats.latency_min = tc;
+  if(tc > adc_stats.latency_max)
+    adc_stats.latency_max = tc;
+  adc_stats.latency_sum += tc;
+
+  for(; head != end; head++) {
+    data = ring[head & (ADC_RING - 1)];
+    if(data & (1UL<<30))                /* OVERRUN: a result was lost         */
+      adc_stats.overruns++;
+    value = Filter_Step(&filter, (data>>4) & 0xFFF);
+  }
+  adc_stats.samples = head;
+  latest = (head << 16) | value;
+  in = Input_Begin();
+  in->sample = value;
+  Input_Publish();
+}
+
+/*----------------------------------------------------------------------------
+  Called by the GPDMA IRQ when channel 1 stopped on an error: the block
+  it was filling is lost, the ring starts again on it. The filter and
+  the count of the samples go on from the last block
+ *----------------------------------------------------------------------------*/
+void ADC_Error (void) {
+  adc_stats.errors++;
+  StartRing((head / ADC_BLOCK) % (ADC_RING / ADC_BLOCK));
+}
+
+/*----------------------------------------------------------------------------
+  The word published by the interrupt, see ADC_VALUE and ADC_SEQ. A single
+  load: no lock, and never half of two samples
+ *----------------------------------------------------------------------------*/
+uint32_t ADC_Latest (void) {
+  return latest;
+}
+
+/*----------------------------------------------------------------------------
+  The newest filtered sample, at each game step
+ *----------------------------------------------------------------------------*/
+uint16_t ADC_Read (void) {
+  return ADC_VALUE(ADC_Latest());
+}
@@ -1,37 +1,24 @@
 #include "button.h"
 #include "lpc17xx.h"
-#include "../RIT/RIT.h"
-
-extern int key2;
-extern int key1;
-extern int int0;
+#include "../input/input.h"
 
 void EINT0_IRQHandler (void)	  	/* INT0														 */
 {		
-	NVIC_DisableIRQ(EINT0_IRQn);		/* disable Button interrupts			 */
-	LPC_PINCON->PINSEL4    &= ~(1 << 20);     /* GPIO pin selection */
-	int0=1;
+	Input_Wake(IN_INT0);						/* debounced by the RIT						 */
 	LPC_SC->EXTINT &= (1 << 0);     /* clear pending interrupt         */
-	enable_RIT();
 }
 
 
 void EINT1_IRQHandler (void)	  	/* KEY1														 */
 {
-	NVIC_DisableIRQ(EINT1_IRQn);		/* disable Button interrupts			 */
-	LPC_PINCON->PINSEL4    &= ~(1 << 22);     /* GPIO pin selection */
-	key1=1;
+	Input_Wake(IN_KEY1);
 	LPC_SC->EXTINT &= (1 << 1);     /* clear pending interrupt         */
-	enable_RIT();
 }
 
 void EINT2_IRQHandler (void)	  	/* KEY2														 */
 {
-	NVIC_DisableIRQ(EINT2_IRQn);		/* disable Button interrupts			 */
-	LPC_PINCON->PINSEL4    &= ~(1 << 24);     /* GPIO pin selection */
-	key2=1;
+	Input_Wake(IN_KEY2);
   LPC_SC->EXTINT &= (1 << 2);     /* clear pending interrupt         */  
-	enable_RIT();  
 }
 
 
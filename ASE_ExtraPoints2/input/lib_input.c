@@ -0,0 +1,245 @@
+/*********************************************************************************************************
+**--------------File Info---------------------------------------------------------------------------------
+** File name:           lib_input.c
+** Last modified Date:  2026-10-17
+** Last Version:        V1.00
+** Descriptions:        debounce of the buttons and of the joystick, driven by a table
+** Correlated files:    input.h, IRQ_button.c, IRQ_RIT.c, IRQ_systick.c
+**--------------------------------------------------------------------------------------------------------
+*********************************************************************************************************/
+#include "lpc17xx.h"
+#include "input.h"
+#include "../RIT/RIT.h"
+#include "../systick/systick.h"
+
+/* Wiring and times of an input, all of them low while down */
+typedef struct {
+	uint8_t port;								/* GPIO port of the pin												*/
+	uint8_t pin;
+	int8_t eint;								/* EINTn muxed on the pin of port 2, -1 if polled	*/
+	uint16_t debounce;					/* ms it must stay down to be pressed					*/
+	uint16_t long_press;				/* ms down to INPUT_LONG, 0 for none					*/
+	uint16_t repeat;						/* ms between INPUT_REPEAT after it, 0 for none	*/
+} InputPin;
+
+static const InputPin table[INPUTS] = {
+	{ 2, 10,  0, 50, 1000,   0 },		/* INT0																			*/
+	{ 2, 11,  1, 50, 1000,   0 },		/* KEY1																			*/
+	{ 2, 12,  2, 50, 1000,   0 },		/* KEY2																			*/
+	{ 1, 25, -1, 20, 1000,   0 },		/* joystick select													*/
+	{ 1, 26, -1, 20,  400, 100 },		/* joystick down														*/
+	{ 1, 27, -1, 20,  400, 100 },		/* joystick left														*/
+	{ 1, 28, -1, 20,  400, 100 },		/* joystick right														*/
+	{ 1, 29, -1, 20,  400, 100 }		/* joystick up															*/
+};
+
+/* States of an input */
+#define IDLE				0						/* waiting for its EINT or for the poll				*/
+#define SETTLING		1
+#define DOWN				2
+
+static LPC_GPIO_TypeDef *gpio[3];
+static volatile uint8_t state[INPUTS];
+static volatile uint32_t down_time[INPUTS];		/* us of the edge								*/
+static uint32_t held[INPUTS];							/* ms down, the debounce included	*/
+static uint32_t next_event[INPUTS];				/* held of the next long press or repeat, 0 for none */
+static uint32_t enabled, polled;
+static InputHandler report;
+
+#define IS_DOWN(i)	((gpio[table[i].port]->FIOPIN & (1 << table[i].pin)) == 0)
+
+/******************************************************************************
+** Function name:		Rearm
+**
+** Descriptions:		The input is idle again: a button goes back to its EINT.
+**									The pin is muxed and the flags left by the bounces and by
+**									the mux are cleared before the input is IDLE, the EINT
+**									is enabled last
+**
+** parameters:			i: IN_*
+** Returned value:		None
+**
+******************************************************************************/
+static void Rearm( uint32_t i )
+{
+	if(table[i].eint >= 0)
+	{
+		LPC_PINCON->PINSEL4 |= (1 << (2 * table[i].pin));		/* External interrupt pin selection */
+		LPC_SC->EXTINT = (1 << table[i].eint);								/* clear pending interrupt */
+		NVIC_ClearPendingIRQ((IRQn_Type)(EINT0_IRQn + table[i].eint));
+	}
+	state[i] = IDLE;
+	if(table[i].eint >= 0)
+	{
+		NVIC_EnableIRQ((IRQn_Type)(EINT0_IRQn + table[i].eint));
+	}
+}
+
+/******************************************************************************
+** Function name:		Input_Init
+**
+** Descriptions:		Set up the driver, the RIT stays off until an input wakes.
+**									The pins are set up by BUTTON_init and joystick_init
+**
+** parameters:			inputs: mask of the IN_* to debounce
+**									handler: called from the RIT for each INPUT_* event
+** Returned value:		None
+**
+******************************************************************************/
+void Input_Init( uint32_t inputs, InputHandler handler )
+{
+	uint32_t i;
+
+	gpio[0] = LPC_GPIO0;
+	gpio[1] = LPC_GPIO1;
+	gpio[2] = LPC_GPIO2;
+	report = handler;
+	polled = 0;
+	for(i = 0; i < INPUTS; i++)
+	{
+		state[i] = IDLE;
+		if(table[i].eint < 0)
+		{
+			polled |= 1 << i;
+		}
+	}
+	polled &= inputs;
+	enabled = inputs;
+	init_RIT(SystemFrequency / 1000 * INPUT_TICK);
+}
+
+/******************************************************************************
+** Function name:		Input_Wake
+**
+** Descriptions:		An idle input went down: take the time of the edge and
+**									start the RIT if it is off. A button is muxed as GPIO
+**									and its EINT is off until it is idle again. Called from
+**									the EINT handlers and from Input_Poll
+**
+** parameters:			input: IN_*
+** Returned value:		None
+**
+******************************************************************************/
+void Input_Wake( uint16_t input )
+{
+	if(!(enabled & (1 << input)) || state[input] != IDLE)
+	{
+		return;
+	}
+	if(table[input].eint >= 0)
+	{
+		NVIC_DisableIRQ((IRQn_Type)(EINT0_IRQn + table[input].eint));
+		LPC_PINCON->PINSEL4 &= ~(3 << (2 * table[input].pin));		/* GPIO pin selection */
+	}
+	down_time[input] = read_SysTick_us();
+	held[input] = 0;
+	state[input] = SETTLING;
+	/* On, the RIT is ticking for another input: Input_Tick turns it off only after a last look */
+	if(!(LPC_RIT->RICTRL & (1 << 3)))
+	{
+		reset_RIT();
+		enable_RIT();
+	}
+}
+
+/******************************************************************************
+** Function name:		Input_Poll
+**
+** Descriptions:		The joystick has no interrupt on port 1: SysTick looks at
+**									its idle pins every ms and wakes the ones that are down
+**
+** parameters:			None
+** Returned value:		None
+**
+******************************************************************************/
+void Input_Poll( void )
+{
+	uint32_t i;
+
+	if(polled == 0)
+	{
+		return;
+	}
+	for(i = 0; i < INPUTS; i++)
+	{
+		if((polled & (1 << i)) && state[i] == IDLE && IS_DOWN(i))
+		{
+			Input_Wake(i);
+		}
+	}
+}
+
+/******************************************************************************
+** Function name:		Input_Tick
+**
+** Descriptions:		Debounce of the inputs that are not idle, every INPUT_TICK
+**									ms. A bounce rearms the input, a press is reported after
+**									its debounce time, then the long press and the repeats
+**									while it is held. With all the inputs idle the RIT is
+**									turned off. The RIT interrupt is cleared before
+**
+** parameters:			None
+** Returned value:		None
+**
+******************************************************************************/
+void Input_Tick( void )
+{
+	uint32_t i, now, busy = 0;
+
+	now = read_SysTick_us();
+	for(i = 0; i < INPUTS; i++)
+	{
+		switch(state[i])
+		{
+			case SETTLING:
+				if(!IS_DOWN(i))
+				{
+					Rearm(i);
+					break;
+				}
+				held[i] += INPUT_TICK;
+				if(held[i] >= table[i].debounce)
+				{
+					state[i] = DOWN;
+					next_event[i] = table[i].long_press;
+					report(i, INPUT_PRESS, down_time[i]);
+				}
+				busy = 1;
+				break;
+			case DOWN:
+				if(!IS_DOWN(i))
+				{
+					report(i, INPUT_RELEASE, now);
+					Rearm(i);
+					break;
+				}
+				held[i] += INPUT_TICK;
+				if(next_event[i] != 0 && held[i] >= next_event[i])
+				{
+					report(i, next_event[i] == table[i].long_press ? INPUT_LONG : INPUT_REPEAT, now);
+					next_event[i] = table[i].repeat != 0 ? next_event[i] + table[i].repeat : 0;
+				}
+				busy = 1;
+				break;
+			default:
+				break;
+		}
+	}
+	if(!busy)
+	{
+		disable_RIT();
+		/* An input woken during the scan saw the RIT on and left it running */
+		for(i = 0; i < INPUTS; i++)
+		{
+			if(state[i] != IDLE)
+			{
+				enable_RIT();
+				break;
+			}
+		}
+	}
+}
+
+/******************************************************************************
+**                            End Of File
+******************************************************************************/
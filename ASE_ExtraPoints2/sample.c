@@ -30,7 +30,14 @@
 #include "GLCD/AsciiLib.h" 
 #include "TouchPanel/TouchPanel.h"
 #include "timer/timer.h"
+#include "dac/dac.h"
 #include "RIT/RIT.h"
+#include "systick/systick.h"
+#include "input/input.h"
+#include "MyLib/events.h"
+#include "MyLib/handoff.h"
+#include "MyLib/recorder.h"
+#include "uart/uart.h"
 
 
 /* Led external variables from funct_led */
@@ -39,40 +46,199 @@ extern unsigned char led_value;					/* defined in lib_led								*/
 extern uint8_t ScaleFlag; // <- ScaleFlag needs to visible in order for the emulator to find the symbol (can be placed also inside system_LPC17xx.h but since it is RO, it needs more work)
 #endif
 
+/*
+ * Time to first frame in us, from LCD_Initialization to the start message on screen.
+ * Define PARTIAL_CLEAR to clear the band of the message first and the rest after it
+ */
+uint32_t boot_time;
+
+
+/* The game advances every GAME_STEP ms, on the newest filtered sample of the ADC */
+#define GAME_STEP		25
+/* Steps a late frame may catch up, the lag beyond them is dropped */
+#define MAX_CATCHUP	4
+
+/* Game loop statistics, times in ms, max_event_wait in us */
+uint32_t frame_time;					/* steps and drawing of the last frame				*/
+uint32_t max_frame_time;
+uint32_t frames;
+uint32_t dropped_frames;			/* steps that did not get a frame of their own */
+uint32_t max_event_wait;			/* longest wait of an event, of a press from its edge */
+
 /*----------------------------------------------------------------------------
   Main Program
  *----------------------------------------------------------------------------*/
 int main (void) 
 {
+	uint32_t now, now_us, next_step = 0, steps;
+	Event ev;
+	GameInput input;
+	uint16_t games = 0;										/* games started, by KEY1 or by KEY2			*/
+	uint8_t replay = 0;										/* the last one started is a replay				*/
+	uint16_t over = 0;										/* last game that ended, not played again	*/
+	uint16_t playing = 0;									/* last game that started									*/
+	uint16_t sample;
+	uint16_t held = 0;										/* inputs down at the last frame					*/
+	int running, recording = 0, replaying = 0, exporting = 0;
+	
 	SystemInit();  												/* System Initialization (i.e., PLL)  */
 	
 	
   LCD_Initialization();
-	LCD_Clear(Black);
 	/* Draw the game board */
+#ifdef PARTIAL_CLEAR
+	LCD_FillRect(0, MAX_Y / 2, MAX_X, 16, Black);
+	GUI_Text(MAX_X / 2 - 100, MAX_Y / 2, "Press KEY1 to Start", White, Black);
+	boot_time = LCD_FirstFrame();
+	LCD_FillRect(0, 0, MAX_X, MAX_Y / 2, Black);
+	LCD_FillRect(0, MAX_Y / 2 + 16, MAX_X, MAX_Y / 2 - 16, Black);
+#else
+	LCD_Clear(Black);
 	GUI_Text(MAX_X / 2 - 100, MAX_Y / 2, "Press KEY1 to Start", White, Black);
+	boot_time = LCD_FirstFrame();
+#endif
   LED_init();                           /* LED Initialization                 */
   BUTTON_init();												/* BUTTON Initialization              */
-	/* 
-	 * The priotiry of the ADC is higher than the one of EINT0, 
-	 * so as not to have it at a higher piority than the buttons 
-	 */
-	NVIC_SetPriority(ADC_IRQn, 1);
-	init_RIT(0x002625A0);									/* RIT Initialization 50 msec       	*/
-	enable_RIT();													/* RIT enabled												*/
+	/* The RIT is the only poster of events, it writes the input with the GPDMA of the ADC */
+	NVIC_SetPriority(RIT_IRQn, 1);
+	ADC_init();														/* TIMER1 and the GPDMA, ADC_RATE			*/
+	/* RIT on only while an input is down, the joystick pins are GPIO inputs from reset */
+	Input_Init(INPUT_BUTTONS | INPUT_JOYSTICK, PostInput);
 	
 	LPC_SC->PCON |= 0x1;									/* power-down	mode										*/
 	LPC_SC->PCON &= ~(0x2);	
 	
-	LPC_PINCON->PINSEL1 |= (1<<21);
-	LPC_PINCON->PINSEL1 &= ~(1<<20);
-	LPC_GPIO0->FIODIR |= (1<<26);
+	DAC_init();														/* sounds played by the GPDMA					*/
+	/* The writers of the GameInput share one priority: neither cuts into the other */
+	NVIC_SetPriority(DMA_IRQn, 1);
+	
+	init_SysTick(SystemFrequency / 1000);	/* SysTick Initialization 1 msec			*/
+	UART_init(115200);										/* UART0 for the recordings						*/
 	
   while (1) 
 	{ 
+		now = systick_ms;
+		now_us = read_SysTick_us();
+		/* The interrupts only post: the work of the buttons is done here */
+		while(Event_Get(&ev))
+		{
+			if((int32_t)(now_us - ev.time) > (int32_t)max_event_wait)
+			{
+				max_event_wait = now_us - ev.time;
+			}
+			switch(ev.kind)
+			{
+				case EV_PRESS:
+					switch(PressButton(ev.data))
+					{
+						case PRESS_START:
+							games++;
+							replay = 0;
+							break;
+						case PRESS_REPLAY:
+							games++;
+							replay = 1;
+							break;
+						default:
+							break;
+					}
+					break;
+				default:
+					break;
+			}
+		}
+		/* What the interrupts published, taken as a whole for the steps of this frame */
+		Input_Read(&input);
+		ChooseGame(input.held & ~held);
+		held = input.held;
+		/* The lost game goes out on the UART a FIFO at a time, the loop never waits for it */
+		if(exporting && UART_TxEmpty())
+		{
+			exporting = Recorder_Export(UART_Send, UART_FIFO);
+		}
+		running = start && games != over;
+		/* A new game is recorded, or it is the recorded one played again */
+		if(running && games != playing)
+		{
+			playing = games;
+			replaying = replay;
+			recording = !replay;
+			if(recording)
+			{
+				Recorder_Start();
+			}
+		}
+		/* Before the start and while paused the clock restarts with the game */
+		if(!running || stop)
+		{
+			next_step = now + GAME_STEP;
+		}
+		if(!running || stop || (int32_t)(now - next_step) < 0)
+		{
+			__ASM("wfi");									/* woken up at least every ms					*/
+			continue;
+		}
 		
-		__ASM("wfi");
+		/* 
+		 * Run every step that is due, then draw once: between two steps nothing changes,
+		 * so a frame is drawn as soon as the LCD is free and there is something new
+		 */
+		for(steps = 0; (int32_t)(now - next_step) >= 0 && running; steps++)
+		{
+			if(steps == MAX_CATCHUP)
+			{
+				dropped_frames += (now - next_step) / GAME_STEP + 1;
+				next_step += ((now - next_step) / GAME_STEP + 1) * GAME_STEP;
+				break;
+			}
+			if(recording)
+			{
+				sample = input.sample;
+				Recorder_Step(sample);
+			}
+			else if(!replaying || !Replay_Next(&sample))
+			{
+				/* Past the end of the recording the game goes on live, and it is not recorded */
+				if(replaying)
+				{
+					Replay_Stop();
+					replaying = 0;
+				}
+				sample = input.sample;
+			}
+			/* GameLost has stopped the game, the steps still due are not played */
+			if(PlayGame(sample) & GAME_OVER)
+			{
+				over = games;
+				running = 0;
+			}
+			next_step += GAME_STEP;
+		}
+		/* A lost game leaves the ball below the paddle, where it is not drawn */
+		if(running)
+		{
+			RenderGame();
+		}
+		/* The lost game is exported from the next frame on, the replay is checked against it */
+		else if(recording)
+		{
+			Recorder_Stop();
+			exporting = 1;
+			recording = 0;
+		}
+		else if(replaying)
+		{
+			Replay_Stop();
+			replaying = 0;
+		}
 		
+		dropped_frames += steps > 1 ? steps - 1 : 0;
+		frame_time = systick_ms - now;
+		if(frame_time > max_frame_time)
+		{
+			max_frame_time = frame_time;
+		}
+		frames++;
   }
 
 }
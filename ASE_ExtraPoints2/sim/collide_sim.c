@@ -0,0 +1,292 @@
+/*********************************************************************************************************
+**--------------File Info---------------------------------------------------------------------------------
+** File name:           collide_sim.c
+** Last modified Date:  2026-10-17
+** Last Version:        V1.00
+** Descriptions:        host run of the swept collisions of MyLib/collide.c: random boxes against a
+**                      dense walk of the same move, then random fast balls bouncing in a field of
+**                      1 px walls and paddles, from fixed seeds. Fails on any tunneling
+** Correlated files:    collide.c, ball.c
+**--------------------------------------------------------------------------------------------------------
+*********************************************************************************************************/
+#include <stdio.h>
+#include <stdlib.h>
+#include "../MyLib/collide.h"
+#include "../MyLib/ball.h"
+
+/* Runs of each part, each one from its own seed */
+#define SEEDS					8
+#define SWEEPS				20000			/* random moves against one box, per seed				*/
+#define BALLS					200				/* balls thrown in the field, per seed					*/
+#define STEPS					500				/* steps of a ball															*/
+
+/* Fastest move, in px per step: many times the walls and the paddles */
+#define MAX_MOVE			64
+/* Points of a walk along a move */
+#define WALK					256
+/* Overlap below this, in px, is a touch and the rounding of Q16.16 */
+#define EPS						(2.0 / FIX_ONE)
+
+/* The field of the game, walls of 1 px around it and two paddles */
+#define FIELD_W				240
+#define FIELD_H				320
+#define WALL					1
+#define PADDLE_W			40
+#define PADDLE_H			10
+#define BALL_SIZE			5
+#define OBSTACLES			6
+
+static Box obstacles[OBSTACLES];
+
+/* Path of the ball in the step going on: start, each contact, end */
+static double path_x[BALL_MAX_HITS + 2], path_y[BALL_MAX_HITS + 2];
+static int path_n;
+
+static uint32_t fails, hits, bounces;
+
+/******************************************************************************
+** Function name:		Random
+**
+** Descriptions:		A random value in [lo, hi], in px
+**
+** parameters:			lo, hi: bounds, in px
+** Returned value:		the value, in Q16.16
+**
+******************************************************************************/
+static fix16_t Random(double lo, double hi)
+{
+	return (fix16_t)((lo + (hi - lo) * rand() / RAND_MAX) * FIX_ONE);
+}
+
+/******************************************************************************
+** Function name:		Overlap
+**
+** Descriptions:		Whether a box at (x, y) is inside another one by more
+**									than EPS on both axes
+**
+** parameters:			x, y: top-left corner of the box, in px
+**									w, h: its size, in px
+**									b: the other box
+** Returned value:		1 on an overlap, 0 otherwise
+**
+******************************************************************************/
+static int Overlap(double x, double y, double w, double h, const Box *b)
+{
+	double bx = (double)b->x / FIX_ONE, by = (double)b->y / FIX_ONE;
+	double bw = (double)b->w / FIX_ONE, bh = (double)b->h / FIX_ONE;
+
+	return x + w > bx + EPS && x < bx + bw - EPS && y + h > by + EPS && y < by + bh - EPS;
+}
+
+/******************************************************************************
+** Function name:		Walk
+**
+** Descriptions:		Walk a box along a straight move and find the first point
+**									inside another box, the reference of Collide_Sweep
+**
+** parameters:			x0, y0: start of the box, in px
+**									x1, y1: end of the box, in px
+**									w, h: its size, in px
+**									b: the still box
+** Returned value:		the fraction of the move of the first overlap, -1 if none
+**
+******************************************************************************/
+static double Walk(double x0, double y0, double x1, double y1, double w, double h, const Box *b)
+{
+	int i;
+	double t;
+
+	for(i = 0; i <= WALK; i++)
+	{
+		t = (double)i / WALK;
+		if(Overlap(x0 + (x1 - x0) * t, y0 + (y1 - y0) * t, w, h, b))
+			return t;
+	}
+	return -1;
+}
+
+/******************************************************************************
+** Function name:		TestSweeps
+**
+** Descriptions:		Random boxes, thin to wide, moved by up to MAX_MOVE px
+**									against one still box: whenever the walk goes through the
+**									box, Collide_Sweep must report a hit no later than it
+**
+** parameters:			seed: of rand
+** Returned value:		None
+**
+******************************************************************************/
+static void TestSweeps(unsigned seed)
+{
+	Box moving, target;
+	Hit hit;
+	fix16_t dx, dy;
+	double x0, y0, w, h, t;
+	uint32_t i;
+	int hit_found;
+
+	srand(seed);
+	for(i = 0; i < SWEEPS; i++)
+	{
+		target.x = Random(-20, 20);
+		target.y = Random(-20, 20);
+		target.w = Random(0.25, 12);
+		target.h = Random(0.25, 12);
+		moving.w = Random(0.25, 8);
+		moving.h = Random(0.25, 8);
+		moving.x = Random(-80, 80);
+		moving.y = Random(-80, 80);
+		dx = Random(-2 * MAX_MOVE, 2 * MAX_MOVE);
+		dy = Random(-2 * MAX_MOVE, 2 * MAX_MOVE);
+		if(Collide_Sweep(&moving, 0, 0, &target, &hit) || Overlap((double)moving.x / FIX_ONE,
+			(double)moving.y / FIX_ONE, (double)moving.w / FIX_ONE, (double)moving.h / FIX_ONE, &target))
+		{
+			continue;			/* starts inside: not a move through the box */
+		}
+
+		x0 = (double)moving.x / FIX_ONE;
+		y0 = (double)moving.y / FIX_ONE;
+		w = (double)moving.w / FIX_ONE;
+		h = (double)moving.h / FIX_ONE;
+		t = Walk(x0, y0, x0 + (double)dx / FIX_ONE, y0 + (double)dy / FIX_ONE, w, h, &target);
+		hit_found = Collide_Sweep(&moving, dx, dy, &target, &hit);
+		if(t < 0)
+			continue;
+		hits++;
+		if(!hit_found)
+		{
+			printf("FAIL: seed %u, sweep %u: (%.4f, %.4f) by (%.4f, %.4f) goes through a box, no hit\n",
+				seed, (unsigned)i, x0, y0, (double)dx / FIX_ONE, (double)dy / FIX_ONE);
+			fails++;
+		}
+		else if((double)hit.t / FIX_ONE > t + 1.0 / WALK)
+		{
+			printf("FAIL: seed %u, sweep %u: hit at %.4f, inside the box at %.4f\n",
+				seed, (unsigned)i, (double)hit.t / FIX_ONE, t);
+			fails++;
+		}
+	}
+}
+
+/******************************************************************************
+** Function name:		Bounce
+**
+** Descriptions:		Bounce of Ball_Move: the contact goes into the path of the
+**									step, then a plain reflection
+**
+** parameters:			ball: at the contact
+**									index: obstacle hit
+**									hit: contact
+** Returned value:		None
+**
+******************************************************************************/
+static void Bounce(Ball *ball, int index, const Hit *hit)
+{
+	(void)index;
+	if(path_n < BALL_MAX_HITS + 1)
+	{
+		path_x[path_n] = (double)ball->x / FIX_ONE;
+		path_y[path_n] = (double)ball->y / FIX_ONE;
+		path_n++;
+	}
+	bounces++;
+	Ball_Reflect(ball, hit);
+}
+
+/******************************************************************************
+** Function name:		TestBalls
+**
+** Descriptions:		Random fast balls in the field: each leg of each step is
+**									walked, and no point of it may be inside a wall or a
+**									paddle. The ball must also stay in the field
+**
+** parameters:			seed: of rand
+** Returned value:		None
+**
+******************************************************************************/
+static void TestBalls(unsigned seed)
+{
+	Ball ball;
+	uint32_t b, s;
+	int i, j, bad;
+	double size = BALL_SIZE;
+
+	srand(seed);
+	for(b = 0; b < BALLS; b++)
+	{
+		/* Walls of 1 px around the field */
+		obstacles[0].x = FIX(-WALL);	obstacles[0].y = FIX(-WALL);
+		obstacles[0].w = FIX(FIELD_W + 2 * WALL);	obstacles[0].h = FIX(WALL);
+		obstacles[1].x = FIX(-WALL);	obstacles[1].y = FIX(FIELD_H);
+		obstacles[1].w = FIX(FIELD_W + 2 * WALL);	obstacles[1].h = FIX(WALL);
+		obstacles[2].x = FIX(-WALL);	obstacles[2].y = FIX(0);
+		obstacles[2].w = FIX(WALL);	obstacles[2].h = FIX(FIELD_H);
+		obstacles[3].x = FIX(FIELD_W);	obstacles[3].y = FIX(0);
+		obstacles[3].w = FIX(WALL);	obstacles[3].h = FIX(FIELD_H);
+		/* The paddles, somewhere along their rows */
+		obstacles[4].x = Random(0, FIELD_W - PADDLE_W);	obstacles[4].y = FIX(32);
+		obstacles[4].w = FIX(PADDLE_W);	obstacles[4].h = FIX(PADDLE_H);
+		obstacles[5].x = Random(0, FIELD_W - PADDLE_W);	obstacles[5].y = FIX(FIELD_H - 32 - PADDLE_H);
+		obstacles[5].w = FIX(PADDLE_W);	obstacles[5].h = FIX(PADDLE_H);
+
+		/* Anywhere between the paddles, up to MAX_MOVE px per step */
+		Ball_Init(&ball, 0, 0, BALL_SIZE, Random(-MAX_MOVE, MAX_MOVE), Random(-MAX_MOVE, MAX_MOVE));
+		ball.x = Random(0, FIELD_W - BALL_SIZE);
+		ball.y = Random(32 + PADDLE_H, FIELD_H - 32 - PADDLE_H - BALL_SIZE);
+
+		for(s = 0; s < STEPS; s++)
+		{
+			path_x[0] = (double)ball.x / FIX_ONE;
+			path_y[0] = (double)ball.y / FIX_ONE;
+			path_n = 1;
+			Ball_Move(&ball, obstacles, OBSTACLES, Bounce);
+			path_x[path_n] = (double)ball.x / FIX_ONE;
+			path_y[path_n] = (double)ball.y / FIX_ONE;
+
+			bad = 0;
+			for(i = 0; i < path_n && !bad; i++)
+			{
+				for(j = 0; j < OBSTACLES && !bad; j++)
+				{
+					if(Walk(path_x[i], path_y[i], path_x[i + 1], path_y[i + 1], size, size, &obstacles[j]) >= 0)
+					{
+						printf("FAIL: seed %u, ball %u, step %u: (%.4f, %.4f) to (%.4f, %.4f) goes through obstacle %d\n",
+							seed, (unsigned)b, (unsigned)s, path_x[i], path_y[i], path_x[i + 1], path_y[i + 1], j);
+						bad = 1;
+					}
+				}
+			}
+			if(!bad && (path_x[path_n] < -EPS || path_x[path_n] + size > FIELD_W + EPS ||
+				path_y[path_n] < -EPS || path_y[path_n] + size > FIELD_H + EPS))
+			{
+				printf("FAIL: seed %u, ball %u, step %u: out of the field at (%.4f, %.4f)\n",
+					seed, (unsigned)b, (unsigned)s, path_x[path_n], path_y[path_n]);
+				bad = 1;
+			}
+			if(bad)
+			{
+				fails++;
+				break;
+			}
+		}
+	}
+}
+
+int main(void)
+{
+	unsigned seed;
+
+	for(seed = 1; seed <= SEEDS; seed++)
+	{
+		TestSweeps(seed);
+		TestBalls(seed);
+	}
+	printf("%u sweeps through a box, %u bounces of balls up to %d px per step\n",
+		(unsigned)hits, (unsigned)bounces, MAX_MOVE);
+	printf("%u failures\n", (unsigned)fails);
+	return fails != 0;
+}
+
+/******************************************************************************
+**                            End Of File
+******************************************************************************/
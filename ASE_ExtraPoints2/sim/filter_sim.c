@@ -0,0 +1,191 @@
+/*********************************************************************************************************
+**--------------File Info---------------------------------------------------------------------------------
+** File name:           filter_sim.c
+** Last modified Date:  2026-10-17
+** Last Version:        V1.00
+** Descriptions:        host run of the potentiometer filter of MyLib/filter.c: a noisy knob, with
+**                      spikes, filtered at ADC_RATE a block at a time and read at every game step,
+**                      against the single sample and the 5px dead-band the paddle had before
+** Correlated files:    filter.c, lib_adc.c, game.c
+**--------------------------------------------------------------------------------------------------------
+*********************************************************************************************************/
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+#include "../MyLib/filter.h"
+#include "../MyLib/game.h"
+
+/* The rate and the block of adc/adc.h, the step of sample.c */
+#define RATE				4000
+#define BLOCK				16
+#define STEP_MS			50
+#define STEPS				2000
+#define NOISE				12.0					/* LSB rms of the knob											*/
+#define SPIKE_EVERY	97						/* samples between two spikes								*/
+
+static uint32_t samples;
+static uint32_t fails;
+
+/******************************************************************************
+** Function name:		Pixel
+**
+** Descriptions:		x of the paddle for a sample with no hysteresis, the one
+**									the knob asks for
+**
+** parameters:			sample: 12 bits
+** Returned value:		x
+**
+******************************************************************************/
+static int Pixel(uint16_t sample)
+{
+	if(sample < MIN_PADDLE)
+		return 6;
+	if(sample > MAX_PADDLE)
+		return MAX_X - 46;
+	return (sample - MIN_PADDLE) * (MAX_X - 52) / (MAX_PADDLE - MIN_PADDLE) + 6;
+}
+
+/******************************************************************************
+** Function name:		Paddle
+**
+** Descriptions:		Move the paddle for a filtered sample, as MovePaddle does
+**
+** parameters:			x: the paddle
+**									sample: 12 bits
+** Returned value:		None
+**
+******************************************************************************/
+static void Paddle(int *x, uint16_t sample)
+{
+	int32_t q;
+
+	if(sample <= MIN_PADDLE || sample >= MAX_PADDLE)
+	{
+		*x = Pixel(sample);
+		return;
+	}
+	q = (int32_t)(sample - MIN_PADDLE) * (MAX_X - 52) * 4 / (MAX_PADDLE - MIN_PADDLE) + 6 * 4;
+	if(q >= *x * 4 + 6 || q <= *x * 4 - 3)
+		*x = q / 4;
+}
+
+/******************************************************************************
+** Function name:		Knob
+**
+** Descriptions:		Where the knob is at a step: still, a jump across the
+**									run, still, a slow turn back
+**
+** parameters:			step: game step
+** Returned value:		the sample without noise
+**
+******************************************************************************/
+static double Knob(uint32_t step)
+{
+	if(step < STEPS / 4)
+		return 1200;
+	if(step < STEPS / 2)
+		return 3000;
+	if(step < 3 * STEPS / 4)
+		return 3000 - (step - STEPS / 2) * 1800.0 / (STEPS / 4);
+	return 1200;
+}
+
+/******************************************************************************
+** Function name:		Noise
+**
+** Descriptions:		Gaussian noise, Box-Muller
+**
+** parameters:			None
+** Returned value:		one value of unit rms
+**
+******************************************************************************/
+static double Noise(void)
+{
+	double u = (rand() + 1.0) / (RAND_MAX + 2.0), v = (rand() + 1.0) / (RAND_MAX + 2.0);
+
+	return sqrt(-2 * log(u)) * cos(2 * 3.14159265358979 * v);
+}
+
+int main(void)
+{
+	Filter filter;
+	uint32_t step, i, per_step = RATE * STEP_MS / 1000;
+	uint32_t moves_still = 0, old_moves_still = 0, lag = 0, old_lag = 0, settled, old_settled;
+	int x = MAX_X / 2 - 20, old_x = 0, last_x = -1, last_old_x = -1, target, err, max_err = 0, old_err, old_max_err = 0;
+	double v;
+	uint16_t raw = 0, value = 0, latest = 0;
+
+	srand(1);
+	Filter_Reset(&filter);
+	settled = old_settled = 1;
+	for(step = 0; step < STEPS; step++)
+	{
+		for(i = 0; i < per_step; i++)
+		{
+			v = Knob(step) + NOISE * Noise();
+			if((samples % SPIKE_EVERY) == 0)
+				v += (samples & 1) ? 1500 : -1500;
+			raw = (uint16_t)(v < 0 ? 0 : v > 4095 ? 4095 : v);
+			/* As the GPDMA interrupt: all filtered, the newest one of a block published */
+			value = Filter_Step(&filter, raw);
+			samples++;
+			if((samples % BLOCK) == 0)
+				latest = value;
+		}
+		target = Pixel((uint16_t)Knob(step));
+		Paddle(&x, latest);
+		/* The old paddle: the newest sample only, moves under 5px ignored */
+		if(step == 0 || Pixel(raw) - old_x >= 5 || Pixel(raw) - old_x <= -5)
+			old_x = Pixel(raw);
+		err = abs(x - target);
+		old_err = abs(old_x - target);
+		/* Still knob: from 10 steps after a change, the paddle should not move */
+		if(step > 10 && Knob(step) == Knob(step - 10))
+		{
+			moves_still += last_x >= 0 && x != last_x;
+			old_moves_still += last_old_x >= 0 && old_x != last_old_x;
+			if(err > max_err)
+				max_err = err;
+			if(old_err > old_max_err)
+				old_max_err = old_err;
+		}
+		/* Steps the paddle takes to reach the knob after the jump */
+		if(step == STEPS / 4)
+			settled = old_settled = 0;
+		if(!settled && err <= 1)
+			settled = 1;
+		else if(!settled)
+			lag++;
+		if(!old_settled && old_err <= 5)
+			old_settled = 1;
+		else if(!old_settled)
+			old_lag++;
+		last_x = x;
+		last_old_x = old_x;
+	}
+	printf("filtered:  %3u moves of a still paddle, error %d px, %u steps of lag\n",
+		(unsigned)moves_still, max_err, (unsigned)lag);
+	printf("dead-band: %3u moves of a still paddle, error %d px, %u steps of lag\n",
+		(unsigned)old_moves_still, old_max_err, (unsigned)old_lag);
+	if(max_err > 1)
+	{
+		printf("FAIL: a still paddle is %d px off\n", max_err);
+		fails++;
+	}
+	if(lag > 0)
+	{
+		printf("FAIL: the paddle takes %u steps to follow a jump\n", (unsigned)lag);
+		fails++;
+	}
+	if(moves_still > STEPS / 20)
+	{
+		printf("FAIL: a still paddle moved %u times\n", (unsigned)moves_still);
+		fails++;
+	}
+	printf("%u failures\n", (unsigned)fails);
+	return fails != 0;
+}
+
+/******************************************************************************
+**                            End Of File
+******************************************************************************/
@@ -0,0 +1,58 @@
+/*********************************************************************************************************
+**--------------File Info---------------------------------------------------------------------------------
+** File name:           lib_systick.c
+** Last modified Date:  2026-10-17
+** Last Version:        V1.00
+** Descriptions:        atomic functions to be used by higher sw levels
+** Correlated files:    lib_systick.c, IRQ_systick.c
+**--------------------------------------------------------------------------------------------------------
+*********************************************************************************************************/
+#include "lpc17xx.h"
+#include "systick.h"
+
+/******************************************************************************
+** Function name:		init_SysTick
+**
+** Descriptions:		Initialize SysTick to interrupt every SysTickInterval
+**							core clocks and start it
+**
+** parameters:			SysTickInterval: clocks between two interrupts, up to 2^24
+** Returned value:		0 if the interval does not fit the counter, 1 otherwise
+**
+******************************************************************************/
+uint32_t init_SysTick( uint32_t SysTickInterval )
+{
+  if ( SysTick_Config(SysTickInterval) )
+  {
+	return (0);
+  }
+  /* The game clock must not lose ticks behind the other interrupts */
+  NVIC_SetPriority(SysTick_IRQn, 0);
+  return (1);
+}
+
+/******************************************************************************
+** Function name:		read_SysTick_us
+**
+** Descriptions:		Time since init_SysTick in us, from systick_ms and the
+**									counter. It is read again if a tick came in between
+**
+** parameters:			None
+** Returned value:		us, wrapping every 71 minutes
+**
+******************************************************************************/
+uint32_t read_SysTick_us( void )
+{
+  uint32_t ms, elapsed;
+
+  do
+  {
+	ms = systick_ms;
+	elapsed = SysTick->LOAD - SysTick->VAL;
+  } while(ms != systick_ms);
+  return ms * 1000 + elapsed / (SystemFrequency / 1000000);
+}
+
+/******************************************************************************
+**                            End Of File
+******************************************************************************/
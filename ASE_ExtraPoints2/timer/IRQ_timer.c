@@ -20,27 +20,8 @@
 ** Returned value:		None
 **
 ******************************************************************************/
-uint16_t SinTable[45] =                                       /* ұ                       */
-{
-    410, 467, 523, 576, 627, 673, 714, 749, 778,
-    799, 813, 819, 817, 807, 789, 764, 732, 694, 
-    650, 602, 550, 495, 438, 381, 324, 270, 217,
-    169, 125, 87 , 55 , 30 , 12 , 2  , 0  , 6  ,   
-    20 , 41 , 70 , 105, 146, 193, 243, 297, 353
-};
 void TIMER0_IRQHandler (void)
 {
-	static int ticks=0;
-	/* DAC management */
-	LPC_DAC->DACR = SinTable[ticks]<<6;
-	ticks++;
-	LPC_TIM0->MR1 = ticks;
-	if(ticks==45)
-	{
-		ticks=0;
-		disable_timer(0);
-	}
-	
   LPC_TIM0->IR = 1;			/* clear interrupt flag */
   return;
 }
@@ -0,0 +1,112 @@
+/*********************************************************************************************************
+**--------------File Info---------------------------------------------------------------------------------
+** File name:           lib_uart.c
+** Last modified Date:  2026-10-17
+** Last Version:        V1.00
+** Descriptions:        polled transmission on UART0 (COM0 of the board, P0.2 TXD0 and P0.3 RXD0)
+** Correlated files:    uart.h
+**--------------------------------------------------------------------------------------------------------
+*********************************************************************************************************/
+#include "lpc17xx.h"
+#include "uart.h"
+
+/* Fractional divider of the baud rate: 1 + DIVADDVAL / MULVAL = 1.5 */
+#define UART_DIVADDVAL	1
+#define UART_MULVAL			2
+
+/******************************************************************************
+** Function name:		UART_init
+**
+** Descriptions:		Initialize UART0 for 8 data bits, no parity and 1 stop bit.
+**									With PCLK = CCLK / 4 = 25 MHz, 115200 baud comes within 0.5%
+**
+** parameters:			baudrate
+** Returned value:		None
+**
+******************************************************************************/
+void UART_init( uint32_t baudrate )
+{
+	uint32_t pclk = SystemFrequency / 4;		/* PCLKSEL0 reset value for UART0 */
+	uint32_t divisor;
+	
+	/* PCLK / (16 * divisor * 1.5), rounded to the nearest divisor */
+	divisor = (pclk * UART_MULVAL + 8 * (UART_MULVAL + UART_DIVADDVAL) * baudrate) /
+						(16 * (UART_MULVAL + UART_DIVADDVAL) * baudrate);
+	
+	LPC_SC->PCONP |= (1 << 3);							/* power UART0														*/
+	LPC_PINCON->PINSEL0 &= ~(0xF << 4);
+	LPC_PINCON->PINSEL0 |= (1 << 4) | (1 << 6);	/* P0.2 TXD0, P0.3 RXD0									*/
+	
+	LPC_UART0->LCR = 0x83;									/* 8 bits, no parity, 1 stop bit, DLAB = 1	*/
+	LPC_UART0->DLM = divisor >> 8;
+	LPC_UART0->DLL = divisor & 0xFF;
+	LPC_UART0->FDR = (UART_MULVAL << 4) | UART_DIVADDVAL;
+	LPC_UART0->LCR = 0x03;									/* DLAB = 0																*/
+	LPC_UART0->FCR = 0x07;									/* enable and reset the FIFOs							*/
+}
+
+/******************************************************************************
+** Function name:		UART_PutChar
+**
+** Descriptions:		Send a character, waiting for room in the transmit FIFO
+**
+** parameters:			c: character
+** Returned value:		None
+**
+******************************************************************************/
+void UART_PutChar( char c )
+{
+	while((LPC_UART0->LSR & (1 << 5)) == 0);	/* THRE: the FIFO is empty */
+	LPC_UART0->THR = c;
+}
+
+/******************************************************************************
+** Function name:		UART_PutString
+**
+** Descriptions:		Send a zero terminated string
+**
+** parameters:			str: string
+** Returned value:		None
+**
+******************************************************************************/
+void UART_PutString( const char *str )
+{
+	while(*str != 0)
+	{
+		UART_PutChar(*str++);
+	}
+}
+
+/******************************************************************************
+** Function name:		UART_TxEmpty
+**
+** Descriptions:		Whether the transmit FIFO is empty: UART_FIFO characters
+**									can then go with UART_Send, with no wait
+**
+** parameters:			None
+** Returned value:		1 if the FIFO is empty
+**
+******************************************************************************/
+int UART_TxEmpty( void )
+{
+	return (LPC_UART0->LSR & (1 << 5)) != 0;		/* THRE */
+}
+
+/******************************************************************************
+** Function name:		UART_Send
+**
+** Descriptions:		Put a character in the transmit FIFO, with no wait: the
+**									caller knows there is room, see UART_TxEmpty
+**
+** parameters:			c: character
+** Returned value:		None
+**
+******************************************************************************/
+void UART_Send( char c )
+{
+	LPC_UART0->THR = c;
+}
+
+/******************************************************************************
+**                            End Of File
+******************************************************************************/
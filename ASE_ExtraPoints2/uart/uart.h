@@ -0,0 +1,26 @@
+/*********************************************************************************************************
+**--------------File Info---------------------------------------------------------------------------------
+** File name:           uart.h
+** Last modified Date:  2026-10-17
+** Last Version:        V1.00
+** Descriptions:        Prototypes of functions included in the lib_uart .c file
+** Correlated files:    lib_uart.c
+**--------------------------------------------------------------------------------------------------------
+*********************************************************************************************************/
+#ifndef __UART_H
+#define __UART_H
+
+/* Characters the transmit FIFO takes when it is empty */
+#define UART_FIFO		16
+
+/* lib_uart.c */
+extern void UART_init( uint32_t baudrate );
+extern void UART_PutChar( char c );
+extern void UART_PutString( const char *str );
+extern int UART_TxEmpty( void );
+extern void UART_Send( char c );
+
+#endif /* end __UART_H */
+/*****************************************************************************
+**                            End Of File
+******************************************************************************/
@@ -14,137 +14,70 @@
 #include "../button_EXINT/button.h"
 #include "../timer/timer.h"
 #include "../TouchPanel/TouchPanel.h"
+#include "../input/input.h"
 
 /******************************************************************************
 ** Function name:		RIT_IRQHandler
 **
-** Descriptions:		REPETITIVE INTERRUPT TIMER handler
+** Descriptions:		REPETITIVE INTERRUPT TIMER handler: on only while an input
+**									is settling or held, it runs the debounce of lib_input
 **
 ** parameters:			None
 ** Returned value:		None
 **
 ******************************************************************************/
 
-int down_INT0=0;
-int down_KEY1=0;
-int down_KEY2=0;
-
 extern int blink_mask;
 //extern int check;
 
 void RIT_IRQHandler (void)
 {						
+	/* Cleared first: Input_Tick may turn the RIT off and on again */
+  LPC_RIT->RICTRL |= 0x1;	/* clear interrupt flag */
+	Input_Tick();
+}
+
+/******************************************************************************
+** Function name:		BoardTest_Input
+**
+** Descriptions:		Handler of lib_input for the board test: the 5 ways of
+**									the joystick, then the 3 buttons, then the touch panel
+**
+** parameters:			input: IN_*
+**									what: INPUT_*
+**									time: us of the event
+** Returned value:		None
+**
+******************************************************************************/
+void BoardTest_Input (uint16_t input, uint16_t what, uint32_t time)
+{
+	static const char *const ways[] = { "    * Select ", "    * Down   ", "    * Left   ", "    * Right   ", "    * Up   " };
+	static const char *const buttons[] = { "      * INT0 ", " * KEY1", " * KEY2 " };
+	static const uint16_t buttons_x[] = { 10, 105, 160 };
 	static int flag=0;
 	static int jways=0;
 	static char str[2]="0";
-	int x,y;
+	int x,y,bit;
+	
+	if(what != INPUT_PRESS)
+		return;
+	
 	/* button management */
-	if(flag==1){
-		/* INT0 */
-		if(down_INT0!=0){ 
-			if((LPC_GPIO2->FIOPIN & (1<<10)) == 0){	/* INT0 pressed */
-				down_INT0++;				
-				switch(down_INT0){
-					case 2:
-						blink_mask &= ~(1<<2);
-						GUI_Text(10, 240, "      * INT0 ", White, Blue);
-						break;
-					default:
-						break;
-				}
-			}
-			else {	/* button released */
-				down_INT0=0;			
-				NVIC_EnableIRQ(EINT0_IRQn);							 /* enable Button interrupts			*/
-				LPC_PINCON->PINSEL4    |= (1 << 20);     /* External interrupt 0 pin selection */
-			}
-		}
-		/* KEY1 */
-		if(down_KEY1!=0){ 
-			if((LPC_GPIO2->FIOPIN & (1<<11)) == 0){	/* KEY1 pressed */
-				down_KEY1++;				
-				switch(down_KEY1){
-					case 2:
-						blink_mask &= ~(1<<1);
-						GUI_Text(105, 240, " * KEY1", White, Blue);
-						break;
-					default:
-						break;
-				}
-			}
-			else {	/* button released */
-				down_KEY1=0;			
-				NVIC_EnableIRQ(EINT1_IRQn);							 /* enable Button interrupts			*/
-				LPC_PINCON->PINSEL4    |= (1 << 22);     /* External interrupt 0 pin selection */
-			}
-		}
-		/* KEY2 */
-		if(down_KEY2!=0){ 
-			if((LPC_GPIO2->FIOPIN & (1<<12)) == 0){	/* KEY2 pressed */
-				down_KEY2++;				
-				switch(down_KEY2){
-					case 2:
-						blink_mask &= ~(1<<0);
-						GUI_Text(160, 240, " * KEY2 ", White, Blue);
-						break;
-					default:
-						break;
-				}
-			}
-			else {	/* button released */
-				down_KEY2=0;			
-				NVIC_EnableIRQ(EINT2_IRQn);							 /* enable Button interrupts			*/
-				LPC_PINCON->PINSEL4    |= (1 << 24);     /* External interrupt 0 pin selection */
-			}
-		}
-	}	
+	if(flag==1 && input <= IN_KEY2){
+		/* INT0 clears bit 2, KEY1 bit 1, KEY2 bit 0 */
+		blink_mask &= ~(1<<(IN_KEY2 - input));
+		GUI_Text(buttons_x[input], 240, (uint8_t *)buttons[input], White, Blue);
+	}
 
-	if(/*check==2 &&*/ flag==0){
-		/* joystick management */
-		if((LPC_GPIO1->FIOPIN & (1<<25)) == 0){	/* Joytick Select pressed */
-			if((blink_mask & (1<<7))!=0){
-				GUI_Text(10, 220, "    * Select ", White, Blue);
-				jways++;
-				str[0]='0'+jways;
-				GUI_Text(114, 220, str, White, Blue);
-				blink_mask &= ~(1<<7);
-			}
-		}
-		else if((LPC_GPIO1->FIOPIN & (1<<26)) == 0){	/* Joytick down pulled */
-			if((blink_mask & (1<<6))!=0){
-				GUI_Text(10, 220, "    * Down   ", White, Blue);
-				jways++;
-				str[0]='0'+jways;
-				GUI_Text(114, 220, str, White, Blue);
-				blink_mask &= ~(1<<6);
-			}
-		}
-		else if((LPC_GPIO1->FIOPIN & (1<<27)) == 0){	/* Joytick left pulled */
-			if((blink_mask & (1<<5))!=0){
-				GUI_Text(10, 220, "    * Left   ", White, Blue);
-				jways++;
-				str[0]='0'+jways;
-				GUI_Text(114, 220, str, White, Blue);
-				blink_mask &= ~(1<<5);
-			}		
-		}
-		else if((LPC_GPIO1->FIOPIN & (1<<28)) == 0){	/* Joytick right pulled */
-			if((blink_mask & (1<<4))!=0){
-				GUI_Text(10, 220, "    * Right   ", White, Blue);
-				jways++;
-				str[0]='0'+jways;
-				GUI_Text(114, 220, str, White, Blue);
-				blink_mask &= ~(1<<4);
-			}					
-		}
-		else if((LPC_GPIO1->FIOPIN & (1<<29)) == 0){	/* Joytick up pulled */
-			if((blink_mask & (1<<3))!=0){
-				GUI_Text(10, 220, "    * Up   ", White, Blue);
-				jways++;
-				str[0]='0'+jways;
-				GUI_Text(114, 220, str, White, Blue);
-				blink_mask &= ~(1<<3);
-			}		
+	if(/*check==2 &&*/ flag==0 && input >= IN_SELECT){
+		/* joystick management: Select clears bit 7 down to Up bit 3 */
+		bit = 7 - (input - IN_SELECT);
+		if((blink_mask & (1<<bit))!=0){
+			GUI_Text(10, 220, (uint8_t *)ways[input - IN_SELECT], White, Blue);
+			jways++;
+			str[0]='0'+jways;
+			GUI_Text(114, 220, (uint8_t *)str, White, Blue);
+			blink_mask &= ~(1<<bit);
 		}
 	}
 	
@@ -181,14 +114,9 @@ void RIT_IRQHandler (void)
 			GUI_Text(10, 280, ">>    everything works   <<", Blue, Green);
 		  GUI_Text(10, 300, ">> you are ready to work <<", Blue, Green);
 		
-			enable_timer(1);
+			Music_Play(MUSIC_OK);
 			disable_timer(3);
 	}
-	/* ADC management */
-	/*if(check!=2)
-		ADC_start_conversion();	*/	
-			
-  LPC_RIT->RICTRL |= 0x1;	/* clear interrupt flag */
 }
 
 /******************************************************************************
@@ -1,35 +1,24 @@
 #include "button.h"
 #include "lpc17xx.h"
-
-extern int down_INT0;
-extern int down_KEY1;
-extern int down_KEY2;
+#include "../input/input.h"
 
 void EINT0_IRQHandler (void)	  	/* INT0														 */
 {		
-	NVIC_DisableIRQ(EINT0_IRQn);		/* disable Button interrupts			 */
-	LPC_PINCON->PINSEL4    &= ~(1 << 20);     /* GPIO pin selection */
-	down_INT0=1;
-	
+	Input_Wake(IN_INT0);						/* debounced by the RIT						 */
 	LPC_SC->EXTINT &= (1 << 0);     /* clear pending interrupt         */
 }
 
 
 void EINT1_IRQHandler (void)	  	/* KEY1														 */
 {
-	NVIC_DisableIRQ(EINT1_IRQn);		/* disable Button interrupts			 */
-	LPC_PINCON->PINSEL4    &= ~(1 << 22);     /* GPIO pin selection */
-	down_KEY1=1;
+	Input_Wake(IN_KEY1);
 	LPC_SC->EXTINT &= (1 << 1);     /* clear pending interrupt         */
 }
 
 void EINT2_IRQHandler (void)	  	/* KEY2														 */
 {
-	NVIC_DisableIRQ(EINT2_IRQn);		/* disable Button interrupts			 */
-	LPC_PINCON->PINSEL4    &= ~(1 << 24);     /* GPIO pin selection */
-	down_KEY2=1;
-	
-  LPC_SC->EXTINT &= (1 << 2);     /* clear pending interrupt         */    
+	Input_Wake(IN_KEY2);
+  LPC_SC->EXTINT &= (1 << 2);     /* clear pending interrupt         */  
 }
 
 
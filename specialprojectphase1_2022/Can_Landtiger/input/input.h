@@ -0,0 +1,53 @@
+/*********************************************************************************************************
+**--------------File Info---------------------------------------------------------------------------------
+** File name:           input.h
+** Last modified Date:  2026-10-17
+** Last Version:        V1.00
+** Descriptions:        Prototypes of functions included in the lib_input .c file
+** Correlated files:    lib_input.c
+**--------------------------------------------------------------------------------------------------------
+*********************************************************************************************************/
+#ifndef __INPUT_H
+#define __INPUT_H
+
+#include <stdint.h>
+
+/*
+ * Inputs of the board, in the order of the table in lib_input.c. The buttons
+ * wake the driver from their EINT interrupt, the joystick from the poll of SysTick
+ */
+#define IN_INT0				0
+#define IN_KEY1				1
+#define IN_KEY2				2
+#define IN_SELECT			3
+#define IN_DOWN				4
+#define IN_LEFT				5
+#define IN_RIGHT			6
+#define IN_UP					7
+#define INPUTS				8
+
+#define INPUT_BUTTONS		((1 << IN_INT0) | (1 << IN_KEY1) | (1 << IN_KEY2))
+#define INPUT_JOYSTICK	(0x1F << IN_SELECT)
+
+/* RIT period while an input is settling or held, in ms */
+#define INPUT_TICK		5
+
+/* What happened to an input */
+#define INPUT_PRESS		1						/* it held down for its debounce time			*/
+#define INPUT_RELEASE	2
+#define INPUT_LONG		3						/* it is still down after its long press	*/
+#define INPUT_REPEAT	4						/* and still down, once every repeat time	*/
+
+/* Called from the RIT, time in us: of the edge for INPUT_PRESS, of the tick for the rest */
+typedef void (*InputHandler)(uint16_t input, uint16_t what, uint32_t time);
+
+/* lib_input.c */
+extern void Input_Init(uint32_t inputs, InputHandler handler);
+extern void Input_Wake(uint16_t input);
+extern void Input_Poll(void);
+extern void Input_Tick(void);
+
+#endif /* end __INPUT_H */
+/*****************************************************************************
+**                            End Of File
+******************************************************************************/
@@ -19,6 +19,9 @@
 #include "TouchPanel/TouchPanel.h"
 #include "timer/timer.h"
 #include "RIT/RIT.h"
+#include "systick/systick.h"
+#include "joystick/joystick.h"
+#include "input/input.h"
 #include "can/can.h"
 
 
@@ -50,8 +53,9 @@ int main (void)
 	 * so as not to have it at a higher piority than the buttons 
 	 */
 	//NVIC_SetPriority(ADC_IRQn, 1);
-	//init_RIT(0x004C4B40);									/* RIT Initialization 50 msec       	*/
-	//enable_RIT();													/* RIT enabled												*/
+	//init_SysTick(SystemFrequency / 1000);	/* SysTick Initialization 1 msec, polls the joystick */
+	//joystick_init();											/* Joystick Initialization            */
+	//Input_Init(INPUT_BUTTONS | INPUT_JOYSTICK, BoardTest_Input);	/* RIT on only while an input is down */
 	
 	//LPC_SC->PCON |= 0x1;									/* power-down	mode										*/
 	//LPC_SC->PCON &= ~(0x2);	
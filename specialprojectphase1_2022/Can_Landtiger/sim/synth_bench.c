@@ -0,0 +1,241 @@
+/*********************************************************************************************************
+**--------------File Info---------------------------------------------------------------------------------
+** File name:           synth_bench.c
+** Last modified Date:  2026-10-17
+** Last Version:        V1.00
+** Descriptions:        host run of synth/synth.c: the pitch and the range of the samples, the end of a
+**                      score, the samples per second of the mixer and a WAV file of a score
+** Correlated files:    synth.c, IRQ_timer.c
+**--------------------------------------------------------------------------------------------------------
+*********************************************************************************************************/
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include "../synth/synth.h"
+
+/* Blocks mixed by the benchmark, about 10 minutes of sound */
+#define BENCH_BLOCKS	300000
+
+/* A4 alone, then a chord of SYNTH_VOICES notes held for the benchmark */
+static const uint16_t a4[] = { SYNTH_NOTE(69, 8), SYNTH_END };
+static const uint16_t chord0[] = { SYNTH_NOTE(48, 255), SYNTH_NOTE(48, 255), SYNTH_END };
+static const uint16_t chord1[] = { SYNTH_NOTE(60, 255), SYNTH_NOTE(60, 255), SYNTH_END };
+static const uint16_t chord2[] = { SYNTH_NOTE(64, 255), SYNTH_NOTE(64, 255), SYNTH_END };
+static const uint16_t chord3[] = { SYNTH_NOTE(67, 255), SYNTH_NOTE(67, 255), SYNTH_END };
+static const uint16_t *const a4_tracks[] = { a4 };
+static const uint16_t *const chord_tracks[SYNTH_VOICES] = { chord0, chord1, chord2, chord3 };
+
+/* The tune of the board test that went wrong, as in IRQ_timer.c */
+static const uint16_t wrong_melody[] = { SYNTH_NOTE(60, 1), SYNTH_NOTE(60, 1), SYNTH_NOTE(60, 1), SYNTH_REST(2),
+																				 SYNTH_NOTE(60, 1), SYNTH_NOTE(60, 1), SYNTH_NOTE(60, 1), SYNTH_REST(2),
+																				 SYNTH_END };
+static const uint16_t wrong_bass[] = { SYNTH_NOTE(48, 3), SYNTH_REST(2), SYNTH_NOTE(48, 3), SYNTH_REST(2), SYNTH_END };
+static const uint16_t *const wrong_tracks[] = { wrong_melody, wrong_bass };
+
+static uint32_t fails;
+
+/******************************************************************************
+** Function name:		CheckPitch
+**
+** Descriptions:		A4 plays at 440 Hz within 0.1%, counted on the rising
+**									zero crossings of the samples while it sustains
+**
+** parameters:			None
+** Returned value:		None
+**
+******************************************************************************/
+static void CheckPitch(void)
+{
+	Synth synth;
+	uint32_t i, first = 0, last = 0, crossings = 0;
+	uint16_t s, prev = SYNTH_MID;
+	double freq;
+
+	Synth_Init(&synth);
+	Synth_Play(&synth, a4_tracks, 1, 125);
+	for(i = 0; i < SYNTH_RATE / 2; i++)
+	{
+		s = Synth_Sample(&synth);
+		/* From 200 ms, in the sustain */
+		if(i > SYNTH_RATE / 5 && prev < SYNTH_MID && s >= SYNTH_MID)
+		{
+			if(crossings == 0)
+				first = i;
+			last = i;
+			crossings++;
+		}
+		prev = s;
+	}
+	freq = crossings > 1 ? (crossings - 1) * (double)SYNTH_RATE / (last - first) : 0;
+	if(freq < 440 * 0.999 || freq > 440 * 1.001)
+	{
+		printf("FAIL pitch: A4 plays at %.2f Hz\n", freq);
+		fails++;
+	}
+	printf("A4       %.2f Hz, increment %u\n", freq, (unsigned)Synth_Inc(69));
+}
+
+/******************************************************************************
+** Function name:		RunScore
+**
+** Descriptions:		Play a score to its end as TIMER0 does: every sample in
+**									10 bits, silence before and after, and the end in the
+**									time of its steps plus a release. Written as 16 bit PCM
+**									if out is not NULL
+**
+** parameters:			name: of the score, for the messages
+**									tracks, tracks_n, step_ms: as Synth_Play
+**									steps: length of the longest track
+**									out: WAV data, or NULL
+** Returned value:		samples played
+**
+******************************************************************************/
+static uint32_t RunScore(const char *name, const uint16_t *const *tracks, uint16_t tracks_n, uint16_t step_ms,
+	uint32_t steps, FILE *out)
+{
+	Synth synth;
+	uint32_t n = 0, limit;
+	uint16_t s;
+	int16_t pcm;
+
+	limit = (steps * step_ms + SYNTH_RELEASE_MS + 10) * (SYNTH_RATE / 1000 + 1);
+	Synth_Init(&synth);
+	Synth_Play(&synth, tracks, tracks_n, step_ms);
+	while(synth.busy || synth.next != SYNTH_BLOCK)
+	{
+		s = Synth_Sample(&synth);
+		if(s > 1023)
+		{
+			printf("FAIL %s: sample %u is %u\n", name, (unsigned)n, (unsigned)s);
+			fails++;
+			break;
+		}
+		if(out != NULL)
+		{
+			pcm = (int16_t)((s - SYNTH_MID) * 64);
+			fwrite(&pcm, sizeof(pcm), 1, out);
+		}
+		n++;
+		if(n > limit)
+		{
+			printf("FAIL %s: still playing after %u samples\n", name, (unsigned)n);
+			fails++;
+			break;
+		}
+	}
+	if(synth.block[SYNTH_BLOCK - 1] != SYNTH_MID)
+	{
+		printf("FAIL %s: it ends at %u\n", name, (unsigned)synth.block[SYNTH_BLOCK - 1]);
+		fails++;
+	}
+	printf("%-8s %6u samples %7.1f ms\n", name, (unsigned)n, n * 1000.0 / SYNTH_RATE);
+	return n;
+}
+
+/******************************************************************************
+** Function name:		Bench
+**
+** Descriptions:		Samples per second of Synth_Mix with 1 to SYNTH_VOICES
+**									voices held, against the SYNTH_RATE TIMER0 asks for
+**
+** parameters:			None
+** Returned value:		None
+**
+******************************************************************************/
+static void Bench(void)
+{
+	static uint16_t out[SYNTH_BLOCK];
+	Synth synth;
+	uint32_t i, sum = 0;
+	uint16_t voices;
+	clock_t start;
+	double seconds, rate;
+
+	for(voices = 1; voices <= SYNTH_VOICES; voices++)
+	{
+		Synth_Init(&synth);
+		Synth_Play(&synth, chord_tracks, voices, 1000);
+		start = clock();
+		for(i = 0; i < BENCH_BLOCKS; i++)
+		{
+			Synth_Mix(&synth, out);
+			sum += out[i % SYNTH_BLOCK];
+		}
+		seconds = (double)(clock() - start) / CLOCKS_PER_SEC;
+		rate = seconds > 0 ? (double)BENCH_BLOCKS * SYNTH_BLOCK / seconds : 0;
+		printf("%u voices %12.0f samples/s  %8.0f x SYNTH_RATE\n", (unsigned)voices, rate, rate / SYNTH_RATE);
+	}
+	/* Keeps the mixing from being optimised away */
+	if(sum == 0)
+	{
+		printf("FAIL bench: silence\n");
+		fails++;
+	}
+}
+
+/******************************************************************************
+** Function name:		WriteWav
+**
+** Descriptions:		Write the tune of the board test that went wrong as a
+**									mono 16 bit WAV file at SYNTH_RATE
+**
+** parameters:			path: WAV file
+** Returned value:		0 on error
+**
+******************************************************************************/
+static int WriteWav(const char *path)
+{
+	FILE *f = fopen(path, "wb");
+	uint32_t samples, v;
+	uint16_t w;
+
+	if(f == NULL)
+	{
+		perror(path);
+		return 0;
+	}
+	fseek(f, 44, SEEK_SET);
+	samples = RunScore("wav", wrong_tracks, 2, 125, 10, f);
+	fseek(f, 0, SEEK_SET);
+	fwrite("RIFF", 1, 4, f);
+	v = 36 + samples * 2; fwrite(&v, 4, 1, f);
+	fwrite("WAVEfmt ", 1, 8, f);
+	v = 16; fwrite(&v, 4, 1, f);
+	w = 1; fwrite(&w, 2, 1, f);
+	w = 1; fwrite(&w, 2, 1, f);
+	v = SYNTH_RATE; fwrite(&v, 4, 1, f);
+	v = SYNTH_RATE * 2; fwrite(&v, 4, 1, f);
+	w = 2; fwrite(&w, 2, 1, f);
+	w = 16; fwrite(&w, 2, 1, f);
+	fwrite("data", 1, 4, f);
+	v = samples * 2; fwrite(&v, 4, 1, f);
+	fclose(f);
+	return 1;
+}
+
+int main(int argc, char **argv)
+{
+	CheckPitch();
+	RunScore("a4", a4_tracks, 1, 125, 8, NULL);
+	RunScore("wrong", wrong_tracks, 2, 125, 10, NULL);
+	RunScore("chord", chord_tracks, SYNTH_VOICES, 10, 510, NULL);
+	/* -w file: write the tune as a WAV file */
+	if(argc == 3 && strcmp(argv[1], "-w") == 0)
+	{
+		if(!WriteWav(argv[2]))
+			return 2;
+	}
+	else if(argc != 1)
+	{
+		fprintf(stderr, "usage: %s [-w file.wav]\n", argv[0]);
+		return 2;
+	}
+	Bench();
+	printf("%u failures\n", (unsigned)fails);
+	return fails != 0;
+}
+
+/******************************************************************************
+**                            End Of File
+******************************************************************************/
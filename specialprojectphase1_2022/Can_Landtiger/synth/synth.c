@@ -0,0 +1,299 @@
+/*********************************************************************************************************
+**--------------File Info---------------------------------------------------------------------------------
+** File name:           synth.c
+** Last modified Date:  2026-10-17
+** Last Version:        V1.00
+** Descriptions:        wavetable synthesizer: phase accumulators, ADSR envelopes and the integer mixer
+** Correlated files:    synth.h, IRQ_timer.c
+**--------------------------------------------------------------------------------------------------------
+*********************************************************************************************************/
+#include <stddef.h>
+#include "synth.h"
+
+/* A period of the sine, Q15 */
+static const int16_t sine[256] = {
+	0, 804, 1608, 2410, 3212, 4011, 4808, 5602, 6393, 7179, 7962, 8739, 9512, 10278, 11039, 11793,
+	12539, 13279, 14010, 14732, 15446, 16151, 16846, 17530, 18204, 18868, 19519, 20159, 20787, 21403, 22005, 22594,
+	23170, 23731, 24279, 24811, 25329, 25832, 26319, 26790, 27245, 27683, 28105, 28510, 28898, 29268, 29621, 29956,
+	30273, 30571, 30852, 31113, 31356, 31580, 31785, 31971, 32137, 32285, 32412, 32521, 32609, 32678, 32728, 32757,
+	32767, 32757, 32728, 32678, 32609, 32521, 32412, 32285, 32137, 31971, 31785, 31580, 31356, 31113, 30852, 30571,
+	30273, 29956, 29621, 29268, 28898, 28510, 28105, 27683, 27245, 26790, 26319, 25832, 25329, 24811, 24279, 23731,
+	23170, 22594, 22005, 21403, 20787, 20159, 19519, 18868, 18204, 17530, 16846, 16151, 15446, 14732, 14010, 13279,
+	12539, 11793, 11039, 10278, 9512, 8739, 7962, 7179, 6393, 5602, 4808, 4011, 3212, 2410, 1608, 804,
+	0, -804, -1608, -2410, -3212, -4011, -4808, -5602, -6393, -7179, -7962, -8739, -9512, -10278, -11039, -11793,
+	-12539, -13279, -14010, -14732, -15446, -16151, -16846, -17530, -18204, -18868, -19519, -20159, -20787, -21403, -22005, -22594,
+	-23170, -23731, -24279, -24811, -25329, -25832, -26319, -26790, -27245, -27683, -28105, -28510, -28898, -29268, -29621, -29956,
+	-30273, -30571, -30852, -31113, -31356, -31580, -31785, -31971, -32137, -32285, -32412, -32521, -32609, -32678, -32728, -32757,
+	-32767, -32757, -32728, -32678, -32609, -32521, -32412, -32285, -32137, -31971, -31785, -31580, -31356, -31113, -30852, -30571,
+	-30273, -29956, -29621, -29268, -28898, -28510, -28105, -27683, -27245, -26790, -26319, -25832, -25329, -24811, -24279, -23731,
+	-23170, -22594, -22005, -21403, -20787, -20159, -19519, -18868, -18204, -17530, -16846, -16151, -15446, -14732, -14010, -13279,
+	-12539, -11793, -11039, -10278, -9512, -8739, -7962, -7179, -6393, -5602, -4808, -4011, -3212, -2410, -1608, -804
+};
+
+/* Phase increments of MIDI 108 to 119 at SYNTH_RATE, the octaves below are shifted */
+static const uint32_t top_octave[12] = {
+	1150641405, 1219062103, 1291551308, 1368350945, 1449717327, 1535922005,
+	1627252680, 1724014160, 1826529376, 1935140465, 2050209905, 2172121730
+};
+
+/* Blocks in a time, the nearest and at least one */
+#define BLOCKS(ms)	(((ms) * SYNTH_RATE + 500 * SYNTH_BLOCK) / (1000 * SYNTH_BLOCK) > 0 ? \
+										 ((ms) * SYNTH_RATE + 500 * SYNTH_BLOCK) / (1000 * SYNTH_BLOCK) : 1)
+
+#define FULL				32767
+#define ATTACK_STEP	(FULL / BLOCKS(SYNTH_ATTACK_MS))
+#define DECAY_STEP	((FULL - SYNTH_LEVEL) / BLOCKS(SYNTH_DECAY_MS))
+#define RELEASE_STEP	(SYNTH_LEVEL / BLOCKS(SYNTH_RELEASE_MS))
+#define GAP					BLOCKS(SYNTH_GAP_MS)
+
+/******************************************************************************
+** Function name:		Synth_Init
+**
+** Descriptions:		All the voices quiet, the next sample mixes a block
+**
+** parameters:			synth: the synthesizer
+** Returned value:		None
+**
+******************************************************************************/
+void Synth_Init( Synth *synth )
+{
+	uint16_t i;
+
+	for(i = 0; i < SYNTH_VOICES; i++)
+	{
+		synth->voice[i].phase = 0;
+		synth->voice[i].inc = 0;
+		synth->voice[i].level = 0;
+		synth->voice[i].stage = SYNTH_OFF;
+		synth->voice[i].track = NULL;
+		synth->voice[i].left = 0;
+	}
+	for(i = 0; i < SYNTH_BLOCK; i++)
+	{
+		synth->block[i] = SYNTH_MID;
+	}
+	synth->step = 1;
+	synth->next = SYNTH_BLOCK;
+	synth->busy = 0;
+}
+
+/******************************************************************************
+** Function name:		Synth_Play
+**
+** Descriptions:		Start a score, one track per voice. The voices without a
+**									track are silenced, the phases go on
+**
+** parameters:			synth: the synthesizer
+**									tracks: SYNTH_NOTE words, each ends with SYNTH_END
+**									tracks_n: tracks, SYNTH_VOICES at most
+**									step_ms: time of a step of the score
+** Returned value:		None
+**
+******************************************************************************/
+void Synth_Play( Synth *synth, const uint16_t *const *tracks, uint16_t tracks_n, uint16_t step_ms )
+{
+	uint16_t i;
+
+	for(i = 0; i < SYNTH_VOICES; i++)
+	{
+		synth->voice[i].track = i < tracks_n ? tracks[i] : NULL;
+		synth->voice[i].left = 0;
+		synth->voice[i].level = 0;
+		synth->voice[i].stage = SYNTH_OFF;
+	}
+	synth->step = BLOCKS((uint32_t)step_ms);
+	synth->busy = 1;
+}
+
+/******************************************************************************
+** Function name:		Synth_Inc
+**
+** Descriptions:		Phase increment of a MIDI pitch, 2^32 * f / SYNTH_RATE.
+**									Pitches above 119 play as 119
+**
+** parameters:			pitch: MIDI note, 69 is A4 at 440 Hz
+** Returned value:		the increment, 0 for pitch 0
+**
+******************************************************************************/
+uint32_t Synth_Inc( uint16_t pitch )
+{
+	if(pitch == 0)
+	{
+		return 0;
+	}
+	if(pitch > 119)
+	{
+		pitch = 119;
+	}
+	return top_octave[pitch % 12] >> (9 - pitch / 12);
+}
+
+/******************************************************************************
+** Function name:		Control
+**
+** Descriptions:		Once per block: the next note of each track when the one
+**									playing is over, then the envelopes. A note releases GAP
+**									blocks before its end, so that the same pitch twice is
+**									heard as two notes
+**
+** parameters:			synth: the synthesizer
+** Returned value:		None
+**
+******************************************************************************/
+static void Control( Synth *synth )
+{
+	SynthVoice *v;
+	uint16_t i, word;
+	uint8_t busy = 0;
+
+	for(i = 0; i < SYNTH_VOICES; i++)
+	{
+		v = &synth->voice[i];
+		if(v->track != NULL && v->left == 0)
+		{
+			word = *v->track;
+			if(word == SYNTH_END)
+			{
+				v->track = NULL;
+			}
+			else
+			{
+				v->track++;
+				v->left = (word & 0xFF) * synth->step;
+			}
+			if(word >> 8)
+			{
+				v->inc = Synth_Inc(word >> 8);
+				v->stage = SYNTH_ATTACK;
+			}
+			else if(v->stage != SYNTH_OFF)
+			{
+				v->stage = SYNTH_RELEASE;
+			}
+		}
+		if(v->left != 0)
+		{
+			if(v->left == GAP && v->stage != SYNTH_OFF)
+			{
+				v->stage = SYNTH_RELEASE;
+			}
+			v->left--;
+		}
+		switch(v->stage)
+		{
+			case SYNTH_ATTACK:
+				v->level += ATTACK_STEP;
+				if(v->level >= FULL)
+				{
+					v->level = FULL;
+					v->stage = SYNTH_DECAY;
+				}
+				break;
+			case SYNTH_DECAY:
+				v->level -= DECAY_STEP;
+				if(v->level <= SYNTH_LEVEL)
+				{
+					v->level = SYNTH_LEVEL;
+					v->stage = SYNTH_SUSTAIN;
+				}
+				break;
+			case SYNTH_RELEASE:
+				v->level -= RELEASE_STEP;
+				if(v->level <= 0)
+				{
+					v->level = 0;
+					v->stage = SYNTH_OFF;
+				}
+				break;
+			default:
+				break;
+		}
+		if(v->track != NULL || v->stage != SYNTH_OFF)
+		{
+			busy = 1;
+		}
+	}
+	synth->busy = busy;
+}
+
+/******************************************************************************
+** Function name:		Synth_Mix
+**
+** Descriptions:		Move the score and the envelopes on by a block, then mix
+**									it. Each voice adds sine * envelope to the sum, the
+**									envelope going from its last level to the new one over
+**									the block. The sum of SYNTH_VOICES full sines, >> 8,
+**									stays in 10 bits around SYNTH_MID
+**
+** parameters:			synth: the synthesizer
+**									out: SYNTH_BLOCK DAC values
+** Returned value:		None
+**
+******************************************************************************/
+void Synth_Mix( Synth *synth, uint16_t *out )
+{
+	int32_t mix[SYNTH_BLOCK];
+	int32_t from[SYNTH_VOICES];
+	int32_t amp, damp;
+	uint32_t phase, inc;
+	SynthVoice *v;
+	uint16_t i, k;
+
+	for(k = 0; k < SYNTH_VOICES; k++)
+	{
+		from[k] = synth->voice[k].level;
+	}
+	Control(synth);
+	for(i = 0; i < SYNTH_BLOCK; i++)
+	{
+		mix[i] = 0;
+	}
+	for(k = 0; k < SYNTH_VOICES; k++)
+	{
+		v = &synth->voice[k];
+		if(from[k] == 0 && v->level == 0)
+		{
+			continue;
+		}
+		/* amp has 5 more bits: it moves by the level difference per sample */
+		phase = v->phase;
+		inc = v->inc;
+		amp = from[k] << 5;
+		damp = v->level - from[k];
+		for(i = 0; i < SYNTH_BLOCK; i++)
+		{
+			mix[i] += (sine[phase >> 24] * (amp >> 5)) >> 15;
+			phase += inc;
+			amp += damp;
+		}
+		v->phase = phase;
+	}
+	for(i = 0; i < SYNTH_BLOCK; i++)
+	{
+		out[i] = (uint16_t)(SYNTH_MID + (mix[i] >> 8));
+	}
+}
+
+/******************************************************************************
+** Function name:		Synth_Sample
+**
+** Descriptions:		The next DAC value, mixing a block when the last one is
+**									over. Called at SYNTH_RATE by TIMER0
+**
+** parameters:			synth: the synthesizer
+** Returned value:		10 bit DAC value
+**
+******************************************************************************/
+uint16_t Synth_Sample( Synth *synth )
+{
+	if(synth->next == SYNTH_BLOCK)
+	{
+		Synth_Mix(synth, synth->block);
+		synth->next = 0;
+	}
+	return synth->block[synth->next++];
+}
+
+/******************************************************************************
+**                            End Of File
+******************************************************************************/
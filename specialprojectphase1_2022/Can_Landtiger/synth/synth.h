@@ -0,0 +1,79 @@
+/*********************************************************************************************************
+**--------------File Info---------------------------------------------------------------------------------
+** File name:           synth.h
+** Last modified Date:  2026-10-17
+** Last Version:        V1.00
+** Descriptions:        prototypes and types of the wavetable synthesizer
+** Correlated files:    synth.c, IRQ_timer.c
+**--------------------------------------------------------------------------------------------------------
+*********************************************************************************************************/
+#ifndef __SYNTH_H
+#define __SYNTH_H
+
+#include <stdint.h>
+
+/*
+ * TIMER0 runs at the fixed SYNTH_RATE and writes one sample to the DAC at each
+ * match. A voice reads the 256 entry sine with the top 8 bits of a 32 bit phase
+ * that grows by the increment of its pitch, so the pitch no longer depends on
+ * the timer. The samples are mixed a block at a time: the score and the ADSR
+ * envelopes move once per block, the envelope ramps inside it. This file has
+ * no register, IRQ_timer.c plays the blocks
+ */
+#define SYNTH_CLOCK			25000000	/* PCLK of TIMER0, CCLK / 4								*/
+#define SYNTH_RATE			15625			/* samples per second											*/
+#define SYNTH_INTERVAL	(SYNTH_CLOCK / SYNTH_RATE - 1)	/* MR0, the TC restarts from 0	*/
+#define SYNTH_BLOCK			32				/* samples mixed in one go, 2.048 ms			*/
+#define SYNTH_VOICES		4
+#define SYNTH_MID				512				/* DAC value of the silence								*/
+
+/* ADSR, the times from silence to full level and back */
+#define SYNTH_ATTACK_MS		10
+#define SYNTH_DECAY_MS		120
+#define SYNTH_LEVEL			20000		/* sustain level, of 32767										*/
+#define SYNTH_RELEASE_MS	60
+#define SYNTH_GAP_MS			20			/* a note releases this long before its end	*/
+
+/*
+ * A note of the score is one word: the MIDI pitch in the high byte, 0 for a
+ * rest, and its length in steps of the score in the low byte. A track is one
+ * voice and ends with 0. Pitches above 119 are beyond SYNTH_RATE / 2
+ */
+#define SYNTH_NOTE(pitch, steps)	((uint16_t)(((pitch) << 8) | (steps)))
+#define SYNTH_REST(steps)					SYNTH_NOTE(0, steps)
+#define SYNTH_END									0
+
+/* Stages of the envelope */
+#define SYNTH_OFF				0
+#define SYNTH_ATTACK		1
+#define SYNTH_DECAY			2
+#define SYNTH_SUSTAIN		3
+#define SYNTH_RELEASE		4
+
+typedef struct {
+	uint32_t phase;							/* of the sine, the top 8 bits index it			*/
+	uint32_t inc;								/* added at each sample, sets the pitch			*/
+	int32_t level;							/* of the envelope, 0 to 32767							*/
+	uint8_t stage;							/* SYNTH_OFF ...														*/
+	const uint16_t *track;			/* next note, NULL when the track is over	*/
+	uint32_t left;							/* blocks of the note still to play				*/
+} SynthVoice;
+
+typedef struct {
+	SynthVoice voice[SYNTH_VOICES];
+	uint32_t step;							/* blocks in a step of the score						*/
+	uint16_t block[SYNTH_BLOCK];	/* DAC values, 10 bits										*/
+	uint16_t next;							/* of block, SYNTH_BLOCK to mix the next one */
+	uint8_t busy;								/* 0 once all the tracks and envelopes end	*/
+} Synth;
+
+void Synth_Init(Synth *synth);
+void Synth_Play(Synth *synth, const uint16_t *const *tracks, uint16_t tracks_n, uint16_t step_ms);
+uint32_t Synth_Inc(uint16_t pitch);
+void Synth_Mix(Synth *synth, uint16_t *out);
+uint16_t Synth_Sample(Synth *synth);
+
+#endif /* end __SYNTH_H */
+/*****************************************************************************
+**                            End Of File
+******************************************************************************/
@@ -11,64 +11,39 @@
 #include "timer.h"
 #include "../led/led.h"
 #include "../GLCD/GLCD.h"
+#include "../synth/synth.h"
 
 
 /******************************************************************************
 ** Function name:		Timer0_IRQHandler
 **
-** Descriptions:		Timer/Counter 0 interrupt handler
+** Descriptions:		Timer/Counter 0 interrupt handler: one sample of the
+**									synthesizer to the DAC at each match, SYNTH_RATE
 **
 ** parameters:			None
 ** Returned value:		None
 **
 ******************************************************************************/
-#define N 10
-
-/* k=1/f'*f/n  k=f/(f'*n) k=25MHz/(f'*45) */
-
-//const int freqs[8]={4240,3779,3367,3175,2834,2525,2249,2120};
-/* 
-131Hz		k=4240 C3
-147Hz		k=3779
-165Hz		k=3367
-175Hz		k=3175
-196Hz		k=2834		
-220Hz		k=2525
-247Hz		k=2249
-262Hz		k=2120 C4
-*/
-
-const int freqs[8]={2120,1890,1684,1592,1417,1263,1125,1062};
-/*
-262Hz	k=2120		c4
-294Hz	k=1890		
-330Hz	k=1684		
-349Hz	k=1592		
-392Hz	k=1417		
-440Hz	k=1263		
-494Hz	k=1125		
-523Hz	k=1062		c5
-
-*/
-
-uint16_t SinTable[45] =                                       /* ұ                       */
-{
-    410, 467, 523, 576, 627, 673, 714, 749, 778,
-    799, 813, 819, 817, 807, 789, 764, 732, 694, 
-    650, 602, 550, 495, 438, 381, 324, 270, 217,
-    169, 125, 87 , 55 , 30 , 12 , 2  , 0  , 6  ,   
-    20 , 41 , 70 , 105, 146, 193, 243, 297, 353
-};
-
-int seq4beats[3][N]={{0,8,7,8,8,8,8,8,8,8},
-										 {0,8,3,8,6,8,5,8,7,8},
-										 {0,0,0,8,8,0,0,0,8,8}};
-/* contains sequence of notes from c4 to C5 */
-/* position of c4 = 0 to C5 - 7 in the freq const vect ADC */ 
-/* position 8 is an artifact to include a pause of 1/4 beat */	
-	
-int play;
-/* current status of sound (on/off) */
+/* Steps of the tunes, from the quarter beats of the old player */
+#define MUSIC_STEP_MS	125
+
+/* C4 is MIDI 60, C5 72 */
+static const uint16_t ok_melody[] = { SYNTH_NOTE(60, 1), SYNTH_REST(1), SYNTH_NOTE(72, 1), SYNTH_REST(7), SYNTH_END };
+static const uint16_t ok_harmony[] = { SYNTH_NOTE(60, 1), SYNTH_REST(1), SYNTH_NOTE(65, 1), SYNTH_REST(1),
+																			 SYNTH_NOTE(71, 1), SYNTH_REST(1), SYNTH_NOTE(69, 1), SYNTH_REST(1),
+																			 SYNTH_NOTE(72, 1), SYNTH_REST(1), SYNTH_END };
+static const uint16_t wrong_melody[] = { SYNTH_NOTE(60, 1), SYNTH_NOTE(60, 1), SYNTH_NOTE(60, 1), SYNTH_REST(2),
+																				 SYNTH_NOTE(60, 1), SYNTH_NOTE(60, 1), SYNTH_NOTE(60, 1), SYNTH_REST(2),
+																				 SYNTH_END };
+static const uint16_t wrong_bass[] = { SYNTH_NOTE(48, 3), SYNTH_REST(2), SYNTH_NOTE(48, 3), SYNTH_REST(2), SYNTH_END };
+
+static const uint16_t *const ok_tracks[] = { ok_melody, ok_harmony };
+static const uint16_t *const wrong_tracks[] = { wrong_melody, wrong_bass };
+static const uint16_t *const *const tunes[MUSIC_TUNES] = { ok_tracks, wrong_tracks };
+static const uint16_t tune_tracks[MUSIC_TUNES] = { 2, 2 };
+
+static Synth synth;
+static uint16_t sample = SYNTH_MID;
 
 int blink_mask = 0xFF;
 
@@ -76,58 +51,21 @@ int blink_mask = 0xFF;
 
 void TIMER0_IRQHandler (void)
 {
-	static int ticks=0;
-	/* DAC management */	
-	//LPC_DAC->DACR = (SinTable[ticks]/3)<<6;
-	ticks++;
-	if(ticks==45) ticks=0;
-	
-  LPC_TIM0->IR = 1;			/* clear interrupt flag */
-  return;
-}
-
-
-/******************************************************************************
-** Function name:		Timer1_IRQHandler
-**
-** Descriptions:		Timer/Counter 1 interrupt handler
-**
-** parameters:			None
-** Returned value:		None
-**
-******************************************************************************/
-int song=0;
-int note=0;
-void TIMER1_IRQHandler (void)
-{  	
-	if(note==N){ 
-		note=0;
-		song++;
-		if(song!=3){
-			disable_timer(1);
-			disable_timer(0);
-		}
-		else{
-			song--;
-		}
-	}
-	else
-		play=seq4beats[song][note++];
-	
-	if(play!=8){
-		disable_timer(0);
-		reset_timer(0);
-		init_timer(0,freqs[play]);
-		enable_timer(0);
-	}
+	/* The sample mixed at the last match goes out first, the mixing adds no jitter */
+	LPC_DAC->DACR = sample << 6;
+	if(synth.busy || synth.next != SYNTH_BLOCK)
+		sample = Synth_Sample(&synth);
 	else{
+		/* The tune is over */
+		sample = SYNTH_MID;
 		disable_timer(0);
 	}
 	
-	LPC_TIM1->IR = 1;			/* clear interrupt flag */
+  LPC_TIM0->IR = 1;			/* clear interrupt flag */
   return;
 }
 
+
 void TIMER2_IRQHandler (void)
 {
 		
@@ -153,14 +91,38 @@ void TIMER3_IRQHandler (void)
 	//check=2;
 	GUI_Text(10, 280, ">> something went wrong <<", White, Red);
 	GUI_Text(10, 300, ">>  reset to try again  <<", White, Red);
-	song=2;
-	note=0;
-	enable_timer(1);	
+	Music_Play(MUSIC_WRONG);
 	LPC_TIM3->IR = 1;			/* clear interrupt flag */
   return;
 }
 
 
+/******************************************************************************
+** Function name:		Music_Play
+**
+** Descriptions:		Play a tune from its start: P0.26 as AOUT and TIMER0 at
+**									SYNTH_RATE, it stops by itself at the end of the tune
+**
+** parameters:			tune: MUSIC_*
+** Returned value:		None
+**
+******************************************************************************/
+void Music_Play (uint8_t tune)
+{
+	disable_timer(0);
+	LPC_PINCON->PINSEL1 |= (1<<21);		/* P0.26 is AOUT */
+	LPC_PINCON->PINSEL1 &= ~(1<<20);
+	LPC_GPIO0->FIODIR |= (1<<26);
+	
+	Synth_Init(&synth);
+	Synth_Play(&synth, tunes[tune], tune_tracks[tune], MUSIC_STEP_MS);
+	sample = SYNTH_MID;
+	reset_timer(0);
+	init_timer(0, SYNTH_INTERVAL);
+	enable_timer(0);
+}
+
+
 /******************************************************************************
 **                            End Of File
 ******************************************************************************/
@@ -17,7 +17,12 @@ extern void disable_timer( uint8_t timer_num );
 extern void reset_timer( uint8_t timer_num );
 /* IRQ_timer.c */
 extern void TIMER0_IRQHandler (void);
-extern void TIMER1_IRQHandler (void);
+extern void Music_Play (uint8_t tune);
+
+/* Tunes of Music_Play */
+#define MUSIC_OK		0
+#define MUSIC_WRONG		1
+#define MUSIC_TUNES		2
 
 #endif /* end __TIMER_H */
 /*****************************************************************************